@@ -8,7 +8,6 @@
 #include <U8g2lib.h>
 #include <Wire.h>
 #include <EEPROM.h>
-#include <PID_v1.h>
 #include "pins.h"
 #include "config.h"
 #include "menu.h"
@@ -16,50 +15,113 @@
 #include "display.h"
 #include "eeprom_manager.h"  // For loadParameters()
 #include "alarms.h"          // For checkAlarms()
+#include "event_log.h"       // For serviceEventLog()
+#include "counters.h"        // For updateCounters()
+#include "serial_commands.h"
+#include "buttons.h"         // For initializeButtons()
+#include "tick.h"            // For initializeTick()
+#include "trend.h"           // For sampleTrend()
+#include "axis.h"            // For axes[]
+#include "speed_sync.h"      // For updateSync()
+#include "watchdog.h"        // For feedWatchdog()
+#include "perf.h"            // For recordCycles()
+#include "diagnostics.h"     // For paintFreeRam()
+#include "fast_trip.h"       // For initializeFastTrip()
+#include "plant_id.h"        // For updatePlantId()
+#include "led_bar.h"         // For updateLedBar()
+#include "annunciator.h"     // For updateAnnunciator()
+#include "program.h"         // For updateProgram()
+#include "setpoint.h"        // For updateSetpoints()
 #include "globals.h"
 
 // Global variables definition
 SystemParameters systemParams;  // Actual definition
-double pidInput = 0, pidOutput = 0, pidSetpoint = 0;
-PID motorPID(&pidInput, &pidOutput, &pidSetpoint, 
-             DEFAULT_KP, DEFAULT_KI, DEFAULT_KD, DIRECT);
-
-// System state
-SystemState currentState = STATE_IDLE;
 
 // Display instance
 U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, U8X8_PIN_NONE);
 
 void setup() {
+  // Initialize all pins, motor outputs off first
+  initializePins();
 
-  Serial.begin(9600);
+  // Paint the free RAM for the stack high-water monitor
+  paintFreeRam();
 
-  // Initialize all pins
-  initializePins();
-  
-  // Initialize display
-  initializeDisplay();
-  
-  // Show splash screen
-  showSplashScreen();
+  Serial.begin(SERIAL_BAUD_RATE);
+
+  // Start button sampling and LED bar dithering from the periodic tick
+  initializeButtons();
+  initializeLedBar();
+  initializeTick();
   
-  // Initialize PID controller
-  motorPID.SetMode(AUTOMATIC);
-  motorPID.SetOutputLimits(0, 255);
+  // Initialize motor axes and their PID controllers
+  initializeAxes();
   
   // Load parameters from EEPROM
   loadParameters();
+
+  // Arm the hardware overcurrent trip, if built in
+  initializeFastTrip();
+
+  // Locate the event log head
+  initializeEventLog();
+
+  // Restore operating counters
+  initializeCounters();
+
+  // Start the plant model fit from its initial guess
+  initializePlantId();
+
+  // Load the speed program
+  initializeProgram();
+
+  // Prepare the external setpoint inputs
+  initializeSetpoints();
+
+  // Open the speed sync link
+  initializeSync();
   
   // Initialize menu system
   initializeMenu();
+
+  // Control is ready: record the reset cause and boot time, start the watchdog
+  initializeWatchdog();
+
+  // The display comes last; the splash is drawn once and held by
+  // updateDisplay() while the control loop already runs
+  initializeDisplay();
+  showSplashScreen();
+
+  Serial.print(F("ready_us="));
+  Serial.println(getBootTime());
 }
 
 void loop() {
-  // Read inputs
-  readInputs();
-  
-  // Update state machine
-  updateStateMachine();
+  // Exchange the speed reference with the other drives
+  updateSync();
+
+  // Advance the speed program, ahead of the control core
+  updateProgram();
+
+  // Take the setpoint of every axis from its source
+  updateSetpoints();
+
+  // Read inputs and update the state machine of every axis in turn
+  for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+    uint32_t start = readCycles();
+    readInputs(axes[i]);
+    recordCycles(PERF_READ_INPUTS, start);
+    updateStateMachine(axes[i]);
+  }
+
+  // Convert the analog setpoint while the ADC is free until the next pass
+  startSetpointConversion();
+
+  // Play the state or alarm pattern on the RGB LED and buzzer
+  updateAnnunciator();
+
+  // Record the trend
+  sampleTrend();
   
   // Update display
   updateDisplay();
@@ -70,14 +132,33 @@ void loop() {
   // Process menu if needed
   processMenu();
 
-  // Call the PID processing function
-  processPID();
+  // Run the PID and handle alarms of every axis
+  for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+    uint32_t start = readCycles();
+    processPID(axes[i]);
+    recordCycles(PERF_PROCESS_PID, start);
+    checkAlarms(axes[i]);
+  }
+
+  // Integrate the response metrics of the active axis
+  updateControlMetrics();
 
-// Debug
-  if (currentState == STATE_RUN)
-  analogWrite(RGB_BLUE_PIN, pidOutput);
+  // The control task completed: feed the watchdog if it ran on schedule
+  feedWatchdog();
 
-  // Handle alarms
-  checkAlarms();
+  // Background plant identification, one fit update at most
+  uint32_t start = readCycles();
+  updatePlantId();
+  recordCycles(PERF_PLANT_ID, start);
 
-} 
\ No newline at end of file
+  // Integrate operating counters
+  updateCounters();
+
+  // Write pending log events after the outputs are updated
+  serviceEventLog();
+  serviceCounters();
+
+  // Handle serial commands
+  processSerialCommands();
+
+}
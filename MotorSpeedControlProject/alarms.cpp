@@ -4,53 +4,65 @@
 
 #include "alarms.h"
 #include "globals.h"
+#include "event_log.h"
+#include "scaling.h"  // For inputScaling
+#include "axis.h"
+#include "speed_sync.h"  // For isReferenceLost()
 
-// Current alarm status
-AlarmType currentAlarm = ALARM_NONE;
-
-// Timer for clearing the alarm
-unsigned long alarmClearTime = 0;
+// Delay before an alarm clears once its condition is gone
 const unsigned long ALARM_CLEAR_DELAY = 5000; // 5 seconds
 
-// Function to check for alarm conditions
-void checkAlarms() {
-    if (isOvercurrent) {
-        currentAlarm = ALARM_OVERCURRENT;
-        currentState = STATE_ALARM;
-        alarmClearTime = millis(); // Reset exit timer
-    } else if (currentSpeed > systemParams.speedFullScale * 1.1) {  // 10% margin
-        currentAlarm = ALARM_OVERSPEED;
-        currentState = STATE_ALARM;
-        alarmClearTime = millis(); // Reset exit timer
-    } else if (currentState == STATE_ALARM) {
-        // If current is below threshold, check elapsed time
-        if (millis() - alarmClearTime >= ALARM_CLEAR_DELAY) {
-            currentAlarm = ALARM_NONE;
-            currentState = STATE_IDLE;
+// Latch an alarm and stop the axis at once, logging it only when it first trips
+void raiseAlarm(MotorAxis& axis, AlarmType alarm) {
+    if (axis.alarm != alarm) {
+        logAlarm(axis, alarm);
+    }
+    axis.alarm = alarm;
+    axis.alarmClearTime = millis(); // Reset exit timer
+    dispatchStateEvent(axis, EVT_FAULT);
+}
+
+// Function to check for alarm conditions not tied to a single sample, and
+// to clear alarms. Overcurrent and overspeed trip in readInputs().
+void checkAlarms(MotorAxis& axis) {
+    if (isMotorRunning(axis) && isReferenceLost()) {
+        raiseAlarm(axis, ALARM_REFERENCE_LOSS);
+    } else if (axis.state == STATE_ALARM) {
+        // Once the condition is gone, wait before clearing
+        if (millis() - axis.alarmClearTime >= ALARM_CLEAR_DELAY) {
+            postStateEvent(axis, EVT_CLEAR);
         }
     }
 }
 
 // Function to reset alarms
-void resetAlarms() {
-    if (currentState == STATE_ALARM) {
-        if (!isOvercurrent && currentSpeed <= systemParams.speedFullScale) {
-            currentAlarm = ALARM_NONE;
-            currentState = STATE_IDLE;
+void resetAlarms(MotorAxis& axis) {
+    if (axis.state == STATE_ALARM) {
+        if (!axis.overcurrent && axis.speed <= systemParams.speedFullScale) {
+            postStateEvent(axis, EVT_CLEAR);
         }
     }
 }
 
 // Function to get alarm description
-const char* getAlarmText() {
-    switch(currentAlarm) {
+const __FlashStringHelper* getAlarmText() {
+    return getAlarmTypeText(activeAxis().alarm);
+}
+
+// Function to get the description of an alarm type
+const __FlashStringHelper* getAlarmTypeText(AlarmType alarm) {
+    switch(alarm) {
         case ALARM_OVERCURRENT:
-            return "OVERCURRENT";
+            return F("OVERCURRENT");
         case ALARM_OVERSPEED:
-            return "OVERSPEED";
+            return F("OVERSPEED");
         case ALARM_SENSOR_FAULT:
-            return "SENSOR FAULT";
+            return F("SENSOR FAULT");
+        case ALARM_REFERENCE_LOSS:
+            return F("REF LOST");
+        case ALARM_START_TIMEOUT:
+            return F("START TIMEOUT");
         default:
-            return "NO ALARM";
+            return F("NO ALARM");
     }
 }
@@ -5,6 +5,7 @@
 #ifndef ALARMS_H
 #define ALARMS_H
 
+#include <Arduino.h>  // For __FlashStringHelper
 #include "config.h"
 #include "pins.h"
 
@@ -13,15 +14,18 @@ enum AlarmType {
     ALARM_NONE,
     ALARM_OVERCURRENT,
     ALARM_OVERSPEED,
-    ALARM_SENSOR_FAULT
+    ALARM_SENSOR_FAULT,
+    ALARM_REFERENCE_LOSS, // Follower lost the sync reference
+    ALARM_START_TIMEOUT   // Soft start did not reach the setpoint in time
 };
 
-// External declarations
-extern AlarmType currentAlarm;
+struct MotorAxis;  // See axis.h
 
 // Function declarations
-void checkAlarms();
-void resetAlarms();
-const char* getAlarmText();
+void raiseAlarm(MotorAxis& axis, AlarmType alarm);
+void checkAlarms(MotorAxis& axis);
+void resetAlarms(MotorAxis& axis);
+const __FlashStringHelper* getAlarmText();
+const __FlashStringHelper* getAlarmTypeText(AlarmType alarm);
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,152 @@
+/*
+ * Annunciator implementation for DC Motor Speed Control Project
+ */
+
+#include "annunciator.h"
+#include <Arduino.h>
+#include "pins.h"
+#include "globals.h"
+#include "axis.h"
+
+// Beep code building blocks: red flash with beep, dark gap, final pause
+#define BEEP           {15, 255, 0, 0, STEP_BUZZER}, {15, 0, 0, 0, 0}
+#define BEEP_PAUSE     {100, 0, 0, 0, 0}, {0, 0, 0, 0, 0}
+
+static const AnnunciatorStep IDLE_STEPS[] PROGMEM = {
+    {100, 0, 255, 0, 0}, {0, 0, 0, 0, 0}
+};
+static const AnnunciatorStep RUN_STEPS[] PROGMEM = {
+    {100, 0, 0, 255, 0}, {0, 0, 0, 0, 0}
+};
+static const AnnunciatorStep RAMP_STEPS[] PROGMEM = {
+    {50, 0, 255, 255, STEP_FADE}, {50, 0, 24, 24, STEP_FADE}, {0, 0, 0, 0, 0}
+};
+static const AnnunciatorStep OVERCURRENT_STEPS[] PROGMEM = {
+    BEEP, BEEP_PAUSE
+};
+static const AnnunciatorStep OVERSPEED_STEPS[] PROGMEM = {
+    BEEP, BEEP, BEEP_PAUSE
+};
+static const AnnunciatorStep SENSOR_FAULT_STEPS[] PROGMEM = {
+    BEEP, BEEP, BEEP, BEEP_PAUSE
+};
+static const AnnunciatorStep REFERENCE_LOSS_STEPS[] PROGMEM = {
+    BEEP, BEEP, BEEP, BEEP, BEEP_PAUSE
+};
+static const AnnunciatorStep START_TIMEOUT_STEPS[] PROGMEM = {
+    BEEP, BEEP, BEEP, BEEP, BEEP, BEEP_PAUSE
+};
+
+// Pattern table, in AnnunciatorPattern order
+static const AnnunciatorStep* const PATTERNS[PATTERN_COUNT] PROGMEM = {
+    IDLE_STEPS, RUN_STEPS, RAMP_STEPS,
+    OVERCURRENT_STEPS, OVERSPEED_STEPS, SENSOR_FAULT_STEPS, REFERENCE_LOSS_STEPS,
+    START_TIMEOUT_STEPS
+};
+
+// Player state
+static uint8_t pattern = PATTERN_COUNT;   // None yet
+static uint8_t stepIndex = 0;
+static AnnunciatorStep step;              // Current step, copied from flash
+static unsigned long stepStart = 0;
+static unsigned long lastFade = 0;
+static uint8_t fromColor[3];              // Colour at the start of the step
+static uint8_t color[3];                  // Colour shown
+static bool buzzerOn = false;
+
+// Show a colour, brightness squared for a more even fade
+static void writeColor(uint8_t red, uint8_t green, uint8_t blue) {
+    color[0] = red;
+    color[1] = green;
+    color[2] = blue;
+    digitalWrite(RGB_RED_PIN, red >= 128 ? HIGH : LOW);
+    analogWrite(RGB_GREEN_PIN, (uint16_t)green * green >> 8);
+    analogWrite(RGB_BLUE_PIN, (uint16_t)blue * blue >> 8);
+}
+
+static void setBuzzer(bool on) {
+    if (on == buzzerOn) {
+        return;
+    }
+    if (on) {
+        tone(BUZZER_PIN, ALARM_BUZZER_FREQ);
+    } else {
+        noTone(BUZZER_PIN);
+    }
+    buzzerOn = on;
+}
+
+// Load step index of the current pattern and apply it
+static void startStep(uint8_t index, unsigned long currentMillis) {
+    const AnnunciatorStep* steps = (const AnnunciatorStep*)pgm_read_ptr(&PATTERNS[pattern]);
+
+    memcpy_P(&step, &steps[index], sizeof(step));
+    if (step.time == 0) {
+        index = 0;
+        memcpy_P(&step, &steps[0], sizeof(step));
+    }
+    stepIndex = index;
+    stepStart = currentMillis;
+    lastFade = currentMillis;
+    memcpy(fromColor, color, sizeof(color));
+
+    if (!(step.flags & STEP_FADE)) {
+        writeColor(step.red, step.green, step.blue);
+    }
+    setBuzzer(step.flags & STEP_BUZZER);
+}
+
+// Alarm of the first axis in alarm, otherwise the state of the active axis
+static uint8_t selectPattern() {
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        if (axes[i].state == STATE_ALARM) {
+            switch (axes[i].alarm) {
+                case ALARM_OVERSPEED:      return PATTERN_OVERSPEED;
+                case ALARM_SENSOR_FAULT:   return PATTERN_SENSOR_FAULT;
+                case ALARM_REFERENCE_LOSS: return PATTERN_REFERENCE_LOSS;
+                case ALARM_START_TIMEOUT:  return PATTERN_START_TIMEOUT;
+                default:                   return PATTERN_OVERCURRENT;
+            }
+        }
+    }
+
+    switch (activeAxis().state) {
+        case STATE_RUN:
+            return PATTERN_RUN;
+        case STATE_STARTING:
+        case STATE_STOPPING:
+            return PATTERN_RAMP;
+        default:
+            return PATTERN_IDLE;
+    }
+}
+
+// Step the pattern, called every loop pass
+void updateAnnunciator() {
+    unsigned long currentMillis = millis();
+    uint8_t selected = selectPattern();
+
+    if (selected != pattern) {
+        pattern = selected;
+        startStep(0, currentMillis);
+        return;
+    }
+
+    unsigned long elapsed = currentMillis - stepStart;
+    unsigned long duration = (unsigned long)step.time * ANNUNCIATOR_TIME_UNIT;
+    if (elapsed >= duration) {
+        startStep(stepIndex + 1, currentMillis);
+        return;
+    }
+
+    if ((step.flags & STEP_FADE) && currentMillis - lastFade >= ANNUNCIATOR_FADE_INTERVAL) {
+        const uint8_t target[3] = {step.red, step.green, step.blue};
+        uint8_t mix[3];
+        for (uint8_t i = 0; i < 3; i++) {
+            int16_t delta = (int16_t)target[i] - fromColor[i];
+            mix[i] = fromColor[i] + delta * (int32_t)elapsed / (int32_t)duration;
+        }
+        writeColor(mix[0], mix[1], mix[2]);
+        lastFade = currentMillis;
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ * Annunciator declarations for DC Motor Speed Control Project
+ *
+ * The RGB LED and the buzzer play patterns: short step lists in flash, each
+ * step holding a colour, a duration and whether the buzzer sounds. A step
+ * can fade linearly from the previous colour. updateAnnunciator() runs from
+ * loop(), compares the time against the current step and only touches the
+ * outputs when a step starts or a fade moves on, so it costs almost nothing
+ * between steps and never waits.
+ *
+ * Every alarm type has its own beep code (1 to 5 beeps, then a pause) with
+ * the red LED flashing in time, so the cause can be told from a distance.
+ * Red is switched, not dimmed: D3 shares TCB1 with tone().
+ */
+
+#ifndef ANNUNCIATOR_H
+#define ANNUNCIATOR_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Patterns
+enum AnnunciatorPattern {
+    PATTERN_IDLE,             // Steady green
+    PATTERN_RUN,              // Steady blue
+    PATTERN_RAMP,             // Cyan breathing while starting or stopping
+    PATTERN_OVERCURRENT,      // 1 beep
+    PATTERN_OVERSPEED,        // 2 beeps
+    PATTERN_SENSOR_FAULT,     // 3 beeps
+    PATTERN_REFERENCE_LOSS,   // 4 beeps
+    PATTERN_START_TIMEOUT,    // 5 beeps
+    PATTERN_COUNT
+};
+
+// Step flags
+enum AnnunciatorFlags {
+    STEP_BUZZER = 0x01,       // Buzzer on for the step
+    STEP_FADE = 0x02          // Fade from the previous colour over the step
+};
+
+// Pattern step (flash), a zero time ends the pattern and repeats it
+struct AnnunciatorStep {
+    uint8_t time;             // Duration in ANNUNCIATOR_TIME_UNIT
+    uint8_t red, green, blue;
+    uint8_t flags;            // AnnunciatorFlags
+};
+
+const uint8_t ANNUNCIATOR_TIME_UNIT = 10;       // ms per step time unit
+const uint8_t ANNUNCIATOR_FADE_INTERVAL = 20;   // Fade update period in ms
+
+// Function declarations
+void updateAnnunciator();
+
+#endif
@@ -0,0 +1,36 @@
+/*
+ * Motor axis implementation for DC Motor Speed Control Project
+ */
+
+#include "axis.h"
+#include "pid.h"
+
+MotorAxis axes[AXIS_COUNT];
+uint8_t selectedAxis = 0;
+
+static_assert(AXIS_COUNT <= 4, "The Axis menu choice lists up to 4 axes");
+
+// Function to reset all axes to IDLE with the PID loop open
+void initializeAxes() {
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        MotorAxis& axis = axes[i];
+
+        memset(&axis, 0, sizeof(axis));
+        axis.pins = &AXIS_PINS[i];
+        axis.state = STATE_IDLE;
+        axis.alarm = ALARM_NONE;
+        initializeFilter(axis.speedFilter, SPEED_FILTER_CHAIN);
+        initializeFilter(axis.currentFilter, CURRENT_FILTER_CHAIN);
+        initializeController(axis.pid);
+        setControllerGains(axis.pid, DEFAULT_KP, DEFAULT_KI, DEFAULT_KD);
+    }
+    selectedAxis = 0;
+}
+
+MotorAxis& activeAxis() {
+    return axes[selectedAxis];
+}
+
+uint8_t getAxisIndex(const MotorAxis& axis) {
+    return &axis - axes;
+}
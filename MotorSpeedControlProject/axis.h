@@ -0,0 +1,63 @@
+/*
+ * Motor axis declarations for DC Motor Speed Control Project
+ *
+ * Every motor is an axis with its own pins, measurements, state, alarm and
+ * PID loop. The control core (readInputs, updateStateMachine, processPID,
+ * checkAlarms) runs for each axis in turn on every loop pass, while the
+ * user interface works on the selected axis. Parameters are shared.
+ */
+
+#ifndef AXIS_H
+#define AXIS_H
+
+#include <stdint.h>
+#include "config.h"
+#include "pins.h"
+#include "states.h"
+#include "alarms.h"
+#include "filters.h"
+#include "pid.h"
+
+// Run time data of one motor
+struct MotorAxis {
+    const AxisPins* pins;
+
+    // Measurements
+    uint16_t speed;                 // Motor speed in RPM
+    uint16_t milliAmps;             // Motor current in mA
+    uint16_t currentRaw;            // Last current reading in ADC counts
+    bool overcurrent;               // Overcurrent condition flag
+    FilterChannel speedFilter;      // Conditioning of the raw inputs
+    FilterChannel currentFilter;
+    unsigned long lastInputTime;    // micros() of the last input sample
+
+    // State machine
+    SystemState state;
+    unsigned long lastStateUpdate;  // Time of the last state machine pass
+    unsigned long stateEnterTime;   // Time the current state was entered
+    uint8_t eventQueue[STATE_EVENT_QUEUE_SIZE];  // StateEvent, oldest at eventHead
+    uint8_t eventHead;
+    uint8_t eventCount;
+    AlarmType alarm;
+    unsigned long alarmClearTime;   // Time the alarm condition was last seen
+
+    // Speed control
+    double pidOutput, pidSetpoint;
+    double localSetpoint;           // Setpoint from the panel (see setpoint.h)
+    uint8_t setpointSource;         // SetpointSource driving pidSetpoint
+    bool setpointSwitching;         // Slewing to a new source
+    SpeedController pid;
+    unsigned long lastPIDCompute;
+    uint8_t pwm;                    // Last value written to the PWM output
+};
+
+// External declarations
+extern MotorAxis axes[AXIS_COUNT];
+extern uint8_t selectedAxis;        // Axis shown and controlled by the UI
+
+// Function declarations
+void initializeAxes();
+MotorAxis& activeAxis();
+uint8_t getAxisIndex(const MotorAxis& axis);
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Microbenchmark implementation for DC Motor Speed Control Project
+ */
+
+#include "bench.h"
+#include <avr/wdt.h>
+#include "globals.h"
+#include "perf.h"     // For readCycles()
+#include "scaling.h"
+#include "utils.h"    // For printFixed()
+#include "display.h"
+#include "axis.h"
+#include "diagnostics.h"  // For STACK_PAINT_PATTERN, staticRamEnd()
+
+// Fixed inputs, volatile so the compiler cannot fold the work away
+static volatile uint16_t fakeRaw = 512;
+static volatile uint16_t sink;
+
+// Scratch speed controller fed with a fixed speed error
+static SpeedController benchPID;
+static volatile float benchInput = 1450;
+static volatile float benchOutput;
+
+// Print that discards its output
+class NullPrint : public Print {
+public:
+    size_t write(uint8_t) { return 1; }
+};
+static NullPrint nullPrint;
+
+static void benchAnalogRead() {
+    sink = analogRead(SPEED_SENSE_PIN);
+}
+
+static void benchScaleInputs() {
+    sink = scaleSpeed(fakeRaw) + scaleCurrent(fakeRaw);
+}
+
+static void benchPIDCompute() {
+    benchOutput = computeController(benchPID, 1500, benchInput, PID_COMPUTE_INTERVAL / 1000.0);
+}
+
+static void benchPrintFixed() {
+    printFixed(nullPrint, 12345, 1, 6);
+}
+
+static void benchRenderMain() {
+    u8g2.clearBuffer();
+    drawHeader();
+    drawMainScreen();
+}
+
+static void benchSendBuffer() {
+    u8g2.sendBuffer();
+}
+
+// Benchmark table
+struct Benchmark {
+    const char* name;   // In flash
+    void (*run)();
+};
+
+#define BENCH_NAME(name, function) static const char BENCH_NAME_##name[] PROGMEM = #name;
+BENCH_LIST(BENCH_NAME)
+
+#define BENCH_ROW(name, function) { BENCH_NAME_##name, function },
+static const Benchmark BENCHMARKS[] PROGMEM = {
+    BENCH_LIST(BENCH_ROW)
+};
+const uint8_t BENCH_COUNT = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+
+// Stack painted by paintStack(), from paintBottom up to paintTop
+static uint8_t* paintBottom;
+static uint8_t* paintTop;
+
+// Paint the free stack below the caller, never below the static data and
+// heap; not inlined so that SP here is below the caller's frame
+static void __attribute__((noinline)) paintStack() {
+    uintptr_t top = SP;
+    uintptr_t bottom = (uintptr_t)staticRamEnd();
+
+    if (bottom > top) {
+        bottom = top;  // The stack already reaches into the heap
+    } else if (top - bottom > BENCH_STACK_DEPTH) {
+        bottom = top - BENCH_STACK_DEPTH;
+    }
+    paintTop = (uint8_t*)top;
+    paintBottom = (uint8_t*)bottom;
+    for (uint8_t* p = paintBottom; p < paintTop; p++) {
+        *p = STACK_PAINT_PATTERN;
+    }
+}
+
+// Bytes of the painted stack that were overwritten
+static uint16_t stackUsed() {
+    uint8_t* p = paintBottom;
+    while (p < paintTop && *p == STACK_PAINT_PATTERN) {
+        p++;
+    }
+    return paintTop - p;
+}
+
+// Run every benchmark and print name_cycles= and name_stack= lines
+bool runBenchmarks(Print& out) {
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        if (axes[i].state != STATE_IDLE) {
+            return false;
+        }
+    }
+
+    // Record the stack high-water mark before the runs repaint the stack
+    checkStack();
+
+    // Cost of reading the counter itself
+    uint32_t start = readCycles();
+    uint32_t overhead = readCycles() - start;
+
+    initializeController(benchPID);
+    setControllerGains(benchPID, systemParams.kp, systemParams.ki, systemParams.kd);
+    startController(benchPID, 100, 1500, benchInput);
+
+    for (uint8_t b = 0; b < BENCH_COUNT; b++) {
+        Benchmark bench;
+        uint32_t fastest = 0xFFFFFFFF;
+        uint16_t deepest = 0;
+
+        memcpy_P(&bench, &BENCHMARKS[b], sizeof(bench));
+
+        for (uint8_t run = 0; run < BENCH_RUNS; run++) {
+            // Start just after a millis() tick, so the timer interrupts fall
+            // at the same points in every run
+            unsigned long now = millis();
+            while (millis() == now) {
+            }
+            wdt_reset();
+
+            paintStack();
+            start = readCycles();
+            bench.run();
+            uint32_t cycles = readCycles() - start - overhead;
+
+            if (cycles < fastest) {
+                fastest = cycles;
+            }
+            uint16_t used = stackUsed();
+            if (used > deepest) {
+                deepest = used;
+            }
+        }
+
+        out.print(FPSTR(bench.name));
+        out.print(F("_cycles="));
+        out.println(fastest);
+        out.print(FPSTR(bench.name));
+        out.print(F("_stack="));
+        out.println(deepest);
+    }
+
+    // The display buffer was overwritten
+    invalidateDisplay();
+    return true;
+}
@@ -0,0 +1,38 @@
+/*
+ * Microbenchmark declarations for DC Motor Speed Control Project
+ *
+ * The BENCH serial command runs each function in the list below a few
+ * times on fixed inputs and reports its CPU cycle count and stack depth,
+ * measured on the target itself. Cycles are read from the tick counter
+ * (perf.h), corrected for the cost of reading it, and the fastest run is
+ * reported; stack depth is found by painting the free stack before a run
+ * and looking for the deepest overwritten byte. Interrupts taken during a
+ * run (tick, millis, I2C) are included in the stack depth.
+ *
+ * Benchmarks stall the loop, so they only run with every motor stopped.
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+
+// Benchmarked functions:
+//   X(name, function)
+#define BENCH_LIST(X) \
+    X(analog_read,   benchAnalogRead) \
+    X(scale_inputs,  benchScaleInputs) \
+    X(pid_compute,   benchPIDCompute) \
+    X(print_fixed,   benchPrintFixed) \
+    X(render_main,   benchRenderMain) \
+    X(send_buffer,   benchSendBuffer)
+
+const uint8_t BENCH_RUNS = 8;               // Runs per benchmark, fastest is reported
+const uint16_t BENCH_STACK_DEPTH = 512;     // Stack painted below the runner in bytes
+
+// Function declarations
+bool runBenchmarks(Print& out);   // false if a motor is running
+
+#endif
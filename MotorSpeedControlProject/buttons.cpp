@@ -0,0 +1,70 @@
+/*
+ * Push button sampling implementation for DC Motor Speed Control Project
+ *
+ * The buttons are sampled from the tick interrupt through precomputed port
+ * registers and masks. Each button has a small integrator: its debounced
+ * state only changes after BUTTON_DEBOUNCE_SAMPLES consistent samples. Press
+ * edges are latched until loop() collects them, so short presses are not
+ * lost while loop() is busy, e.g. during a display transfer.
+ */
+
+#include "buttons.h"
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "pins.h"
+
+static const uint8_t BUTTON_PINS[BUTTON_COUNT] = {
+    BUTTON_UP_PIN, BUTTON_DOWN_PIN, BUTTON_ENTER_PIN, BUTTON_BACK_PIN
+};
+
+// Input registers and masks, resolved once at startup
+static volatile uint8_t* buttonInput[BUTTON_COUNT];
+static uint8_t buttonMask[BUTTON_COUNT];
+
+static uint8_t buttonIntegrator[BUTTON_COUNT];
+static volatile uint8_t buttonState = 0;     // Debounced, bit set = pressed
+static volatile uint8_t buttonPresses = 0;   // Latched press edges
+
+void initializeButtons() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        buttonInput[i] = portInputRegister(digitalPinToPort(BUTTON_PINS[i]));
+        buttonMask[i] = digitalPinToBitMask(BUTTON_PINS[i]);
+        buttonIntegrator[i] = 0;
+    }
+}
+
+// Debounce one sample of every button, called from the tick interrupt
+void sampleButtons() {
+    for (uint8_t i = 0; i < BUTTON_COUNT; i++) {
+        uint8_t bit = 1 << i;
+        bool pressed = (*buttonInput[i] & buttonMask[i]) == 0;  // Active low, pullup
+
+        if (pressed) {
+            if (buttonIntegrator[i] < BUTTON_DEBOUNCE_SAMPLES) {
+                buttonIntegrator[i]++;
+            } else if (!(buttonState & bit)) {
+                buttonState |= bit;
+                buttonPresses |= bit;
+            }
+        } else {
+            if (buttonIntegrator[i] > 0) {
+                buttonIntegrator[i]--;
+            } else {
+                buttonState &= ~bit;
+            }
+        }
+    }
+}
+
+uint8_t getButtonState() {
+    return buttonState;
+}
+
+uint8_t takeButtonPresses() {
+    uint8_t presses;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        presses = buttonPresses;
+        buttonPresses = 0;
+    }
+    return presses;
+}
@@ -0,0 +1,30 @@
+/*
+ * Push button sampling declarations for DC Motor Speed Control Project
+ */
+
+#ifndef BUTTONS_H
+#define BUTTONS_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Button identifiers, also bit positions in the state masks
+enum ButtonId {
+    BUTTON_UP,
+    BUTTON_DOWN,
+    BUTTON_ENTER,
+    BUTTON_BACK,
+    BUTTON_COUNT
+};
+
+// Sampling and debounce
+const uint8_t BUTTON_SAMPLE_TICKS = 5;     // Sample every 5 ticks (5 ms)
+const uint8_t BUTTON_DEBOUNCE_SAMPLES = 4; // Stable samples before a change is accepted (20 ms)
+
+// Function declarations
+void initializeButtons();
+void sampleButtons();          // Called from the tick interrupt
+uint8_t getButtonState();      // Debounced state, one bit per ButtonId
+uint8_t takeButtonPresses();   // Press edges since the previous call
+
+#endif
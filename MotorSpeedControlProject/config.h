@@ -5,6 +5,23 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+#include <stdint.h>
+
+// Build options
+//--------------
+// Hardware overcurrent trip: the AC0 comparator watches the current sensor
+// and cuts the motor PWM from its interrupt (see fast_trip.h). Moves the
+// current sensor to A6 and the speed sensor to A7.
+#ifndef FAST_OVERCURRENT_TRIP
+#define FAST_OVERCURRENT_TRIP 0
+#endif
+
+// External analog setpoint: D12 becomes a 0-5 V setpoint input and the LED
+// bar drops its D12 LED (see setpoint.h).
+#ifndef EXTERNAL_SETPOINT_INPUT
+#define EXTERNAL_SETPOINT_INPUT 0
+#endif
+
 // System parameters default values
 //---------------------------------
 const float DEFAULT_CURRENT_FULL_SCALE = 30.0;  // Maximum current in Ampere
@@ -12,6 +29,16 @@ const int DEFAULT_SPEED_FULL_SCALE = 3000;      // Maximum speed in RPM
 const float DEFAULT_KP = 1.0;                   // Default proportional gain
 const float DEFAULT_KI = 0.0;                   // Default integral gain
 const float DEFAULT_KD = 0.0;                   // Default derivative gain
+const uint8_t DEFAULT_STOP_MODE = 0;            // Default stop policy (STOP_MODE_COAST)
+const uint8_t DEFAULT_SYNC_MODE = 0;            // Default sync role (SYNC_OFF)
+const float DEFAULT_SYNC_RATIO = 1.0;           // Default follower speed ratio
+const int DEFAULT_SYNC_TRIM = 0;                // Default follower speed trim in RPM
+const uint8_t DEFAULT_SPEED_FILTER = 0;         // Default speed IIR time constant (off)
+const uint8_t DEFAULT_CURRENT_FILTER = 2;       // Default current IIR time constant (4 ms)
+const uint8_t DEFAULT_LED_BAR_MODE = 0;         // Default LED bar quantity (LED_BAR_SPEED)
+const uint8_t DEFAULT_SETPOINT_SOURCE = 0;      // Default setpoint source (SOURCE_LOCAL)
+const float DEFAULT_PLANT_GAIN = 0.0;           // No plant baseline stored
+const float DEFAULT_PLANT_TAU = 0.0;
 
 // EEPROM memory map
 //------------------
@@ -20,6 +47,34 @@ const int EEPROM_SPEED_FS_ADDR = 4;     // 4 bytes (int)
 const int EEPROM_KP_ADDR = 8;           // 4 bytes (float)
 const int EEPROM_KI_ADDR = 12;          // 4 bytes (float)
 const int EEPROM_KD_ADDR = 16;          // 4 bytes (float)
+const int EEPROM_STOP_MODE_ADDR = 20;   // 1 byte (uint8_t)
+const int EEPROM_SYNC_MODE_ADDR = 21;   // 1 byte (uint8_t)
+const int EEPROM_SYNC_RATIO_ADDR = 22;  // 4 bytes (float)
+const int EEPROM_SYNC_TRIM_ADDR = 26;   // 2 bytes (int)
+const int EEPROM_SPEED_FILTER_ADDR = 28;    // 1 byte (uint8_t)
+const int EEPROM_CURRENT_FILTER_ADDR = 29;  // 1 byte (uint8_t)
+const int EEPROM_PLANT_GAIN_ADDR = 30;  // 4 bytes (float)
+const int EEPROM_PLANT_TAU_ADDR = 34;   // 4 bytes (float)
+const int EEPROM_LED_BAR_MODE_ADDR = 38;  // 1 byte (uint8_t)
+const int EEPROM_SETPOINT_SOURCE_ADDR = 39;  // 1 byte (uint8_t)
+                                        // 40-47 reserved for parameters
+const int EEPROM_EVENT_LOG_ADDR = 48;   // Event log ring buffer (see event_log.h)
+const int EEPROM_COUNTERS_ADDR = 136;   // Operating counters, two slots (see counters.h)
+const int EEPROM_PROGRAM_ADDR = 204;    // Speed program (see program.h)
+const int EEPROM_SIZE = 256;            // ATmega4809 EEPROM
+
+// Stop policies
+enum StopMode {
+    STOP_MODE_COAST,  // Switch PWM off immediately
+    STOP_MODE_RAMP    // Ramp PWM down over STOP_RAMP_TIME
+};
+
+// Speed sync roles
+enum SyncMode {
+    SYNC_OFF,       // Local setpoint only
+    SYNC_MASTER,    // Broadcast speed reference on the sync link
+    SYNC_FOLLOWER   // Setpoint from the received reference
+};
 
 // System parameters structure
 struct SystemParameters {
@@ -28,19 +83,38 @@ struct SystemParameters {
     float kp;               // Proportional gain
     float ki;               // Integral gain
     float kd;               // Derivative gain
+    uint8_t stopMode;       // Stop policy (StopMode)
+    uint8_t syncMode;       // Speed sync role (SyncMode)
+    float syncRatio;        // Follower setpoint = reference * ratio + trim
+    int syncTrim;           // Follower speed trim in RPM
+    uint8_t speedFilter;    // Speed IIR time constant 2^n ms, 0 = off (see filters.h)
+    uint8_t currentFilter;  // Current IIR time constant 2^n ms, 0 = off
+    float plantGain;        // Plant baseline gain in RPM per PWM count, 0 = none (see plant_id.h)
+    float plantTau;         // Plant baseline time constant in s
+    uint8_t ledBarMode;     // Quantity on the LED bar (LedBarMode, see led_bar.h)
+    uint8_t setpointSource; // Selected setpoint source (SetpointSource, see setpoint.h)
 };
 
 // System timing constants
 //----------------------
-const unsigned long DISPLAY_UPDATE_INTERVAL = 100;   // Display refresh period in ms
+const unsigned long DISPLAY_FAST_INTERVAL = 40;     // Display refresh period while active in ms
+const unsigned long DISPLAY_IDLE_INTERVAL = 1000;   // Display refresh period while idle in ms
+const unsigned long DISPLAY_ACTIVE_TIME = 3000;     // Fast refresh after a button press or value change in ms
+const unsigned long DISPLAY_DIM_TIME = 60000;       // Inactivity before the display dims in ms
+const unsigned long DISPLAY_BLANK_TIME = 600000;    // Inactivity before the display blanks, motors stopped, in ms
 const unsigned long MENU_TIMEOUT = 30000;           // Menu timeout in ms
-const unsigned long LED_BAR_UPDATE_INTERVAL = 100;  // LED bar refresh period in ms
-const unsigned long ALARM_BUZZER_INTERVAL = 500;    // Buzzer toggle period in ms
+const unsigned long LED_BAR_UPDATE_INTERVAL = 20;   // LED bar refresh period in ms
+const unsigned long SOFT_START_TIME = 1500;         // PWM ramp 0-100% on start in ms
+const unsigned long SOFT_START_TIMEOUT = 10000;     // Soft start must reach the setpoint within this time in ms
+const unsigned long STOP_RAMP_TIME = 2000;          // PWM ramp 100-0% on controlled stop in ms
 
 // System thresholds and limits
 //---------------------------
 const float OVERCURRENT_THRESHOLD = 0.9;         // 90% of full scale
+const float OVERSPEED_THRESHOLD = 1.1;           // 110% of full scale
+const float SOFT_START_CURRENT_LIMIT = 0.7;      // Soft start ramp holds above 70% of full scale
 const unsigned int ALARM_BUZZER_FREQ = 2000;     // Buzzer frequency in Hz
 const int ADC_RESOLUTION = 1024;                 // 10-bit ADC resolution
+const uint16_t ADC_REFERENCE_MV = 5000;          // ADC reference (VDD) in mV
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,201 @@
+/*
+ * Operating counters implementation for DC Motor Speed Control Project
+ *
+ * Runtime, charge, energy and speed band time are integrated in fixed point
+ * at control rate. Sub-unit remainders are kept in RAM so no resolution is
+ * lost between ticks. Charge, energy, starts and band time are summed over
+ * all axes, run time counts while any axis runs. The counters are
+ * checkpointed to one of two EEPROM slots in turn, one byte per loop pass;
+ * the slot with the newest valid sequence number is loaded at boot.
+ */
+
+#include "counters.h"
+#include <EEPROM.h>
+#include "globals.h"
+#include "pid.h"
+#include "axis.h"
+
+// Counter slot as stored in EEPROM, packed so that the host tests use the
+// same layout
+struct __attribute__((packed)) CounterSlot {
+    uint8_t sequence;              // Incremented on every checkpoint
+    OperatingCounters counters;
+    uint8_t checksum;              // Detects torn or erased slots
+};
+
+const uint8_t COUNTER_SLOT_COUNT = 2;
+static_assert(EEPROM_COUNTERS_ADDR + COUNTER_SLOT_COUNT * sizeof(CounterSlot) <= EEPROM_PROGRAM_ADDR,
+              "The counter slots must end before the program");
+
+OperatingCounters operatingCounters;
+
+// Sub-unit remainders
+static uint32_t runMsRemainder = 0;       // ms
+static uint32_t chargeRemainder = 0;      // mA*ms
+static uint32_t energyRemainder = 0;      // uJ
+static uint16_t bandMsRemainder[SPEED_BAND_COUNT];
+
+// Checkpoint state
+static CounterSlot saveSlot;
+static uint8_t saveSlotIndex = 0;  // Slot to be written next
+static uint8_t saveStep = 0;       // Bytes of saveSlot already written
+static bool saveInProgress = false;
+static bool countersChanged = false;
+
+static int slotAddress(uint8_t slot) {
+    return EEPROM_COUNTERS_ADDR + slot * sizeof(CounterSlot);
+}
+
+static uint8_t slotChecksum(const CounterSlot& slot) {
+    const uint8_t* bytes = (const uint8_t*)&slot;
+    uint8_t sum = 0x5A;
+    for (uint8_t i = 0; i < sizeof(CounterSlot) - 1; i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+// Load the newest valid checkpoint
+void initializeCounters() {
+    CounterSlot slot;
+    bool found = false;
+    uint8_t newestSequence = 0;
+
+    memset(&operatingCounters, 0, sizeof(operatingCounters));
+    memset(bandMsRemainder, 0, sizeof(bandMsRemainder));
+
+    for (uint8_t i = 0; i < COUNTER_SLOT_COUNT; i++) {
+        EEPROM.get(slotAddress(i), slot);
+        if (slot.checksum != slotChecksum(slot)) {
+            continue;
+        }
+        if (!found || (int8_t)(slot.sequence - newestSequence) > 0) {
+            operatingCounters = slot.counters;
+            newestSequence = slot.sequence;
+            saveSlotIndex = (i + 1) % COUNTER_SLOT_COUNT;
+            found = true;
+        }
+    }
+    saveSlot.sequence = found ? newestSequence : 0;
+}
+
+// Integrate counters, called every loop pass
+void updateCounters() {
+    static unsigned long lastUpdate = 0;
+    static bool wasRunning[AXIS_COUNT];
+    unsigned long currentMillis = millis();
+    unsigned long elapsed = currentMillis - lastUpdate;
+
+    if (elapsed < COUNTERS_UPDATE_INTERVAL) {
+        return;
+    }
+    lastUpdate = currentMillis;
+
+    // Ignore gaps, e.g. after a long blocking call
+    uint16_t dt = elapsed > 1000 ? 1000 : elapsed;
+    bool anyRunning = false;
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const MotorAxis& axis = axes[i];
+        bool running = isMotorRunning(axis);
+
+        if (running && !wasRunning[i]) {
+            operatingCounters.starts++;
+            countersChanged = true;
+        }
+        wasRunning[i] = running;
+
+        if (!running) {
+            continue;
+        }
+        anyRunning = true;
+
+        // Charge: mA*ms, 1e6 per As
+        chargeRemainder += (uint32_t)axis.milliAmps * dt;
+
+        // Energy: supply power scaled by PWM duty, uJ
+        uint32_t powerMilliWatts = (uint32_t)axis.milliAmps * MOTOR_SUPPLY_MILLIVOLTS / 1000;
+        powerMilliWatts = powerMilliWatts * axis.pwm / PID_OUTPUT_MAX;
+        energyRemainder += powerMilliWatts * dt;
+
+        // Speed band histogram
+        uint8_t band = 0;
+        if (axis.speed > 0) {
+            band = (uint32_t)axis.speed * SPEED_BAND_COUNT / systemParams.speedFullScale;
+            if (band >= SPEED_BAND_COUNT) {
+                band = SPEED_BAND_COUNT - 1;
+            }
+        }
+        bandMsRemainder[band] += dt;
+        if (bandMsRemainder[band] >= 1000) {
+            bandMsRemainder[band] -= 1000;
+            operatingCounters.bandSeconds[band]++;
+        }
+    }
+
+    if (!anyRunning) {
+        return;
+    }
+
+    // Runtime, while any axis is running
+    runMsRemainder += dt;
+    while (runMsRemainder >= 1000) {
+        runMsRemainder -= 1000;
+        operatingCounters.runSeconds++;
+    }
+
+    while (chargeRemainder >= 1000000UL) {
+        chargeRemainder -= 1000000UL;
+        operatingCounters.ampSeconds++;
+    }
+    while (energyRemainder >= 1000000UL) {
+        energyRemainder -= 1000000UL;
+        operatingCounters.energyJoules++;
+    }
+
+    countersChanged = true;
+}
+
+// Checkpoint counters to EEPROM at low rate, one byte per call
+void serviceCounters() {
+    static unsigned long lastSave = 0;
+
+    if (!saveInProgress) {
+        if (!countersChanged || millis() - lastSave < COUNTERS_SAVE_INTERVAL) {
+            return;
+        }
+        saveSlot.sequence++;
+        saveSlot.counters = operatingCounters;
+        saveSlot.checksum = slotChecksum(saveSlot);
+        saveStep = 0;
+        saveInProgress = true;
+        countersChanged = false;
+        lastSave = millis();
+    }
+
+    EEPROM.update(slotAddress(saveSlotIndex) + saveStep, ((const uint8_t*)&saveSlot)[saveStep]);
+    if (++saveStep >= sizeof(CounterSlot)) {
+        saveSlotIndex = (saveSlotIndex + 1) % COUNTER_SLOT_COUNT;
+        saveInProgress = false;
+    }
+}
+
+// Print counters as key=value lines
+void printCounters(Print& out) {
+    out.print(F("run_s="));
+    out.println(operatingCounters.runSeconds);
+    out.print(F("starts="));
+    out.println(operatingCounters.starts);
+    out.print(F("charge_As="));
+    out.println(operatingCounters.ampSeconds);
+    out.print(F("energy_J="));
+    out.println(operatingCounters.energyJoules);
+    out.print(F("energy_Wh="));
+    out.println(operatingCounters.energyJoules / 3600);
+    for (uint8_t i = 0; i < SPEED_BAND_COUNT; i++) {
+        out.print(F("band"));
+        out.print(i);
+        out.print(F("_s="));
+        out.println(operatingCounters.bandSeconds[i]);
+    }
+}
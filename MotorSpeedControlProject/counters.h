@@ -0,0 +1,35 @@
+/*
+ * Operating counters declarations for DC Motor Speed Control Project
+ */
+
+#ifndef COUNTERS_H
+#define COUNTERS_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+
+// Counter configuration
+const uint8_t SPEED_BAND_COUNT = 4;                   // Speed histogram bands over full scale
+const unsigned long COUNTERS_UPDATE_INTERVAL = 10;    // Integration period in ms
+const unsigned long COUNTERS_SAVE_INTERVAL = 600000;  // EEPROM checkpoint period in ms (10 min)
+const uint32_t MOTOR_SUPPLY_MILLIVOLTS = 24000;       // Power stage supply for energy estimate
+
+// Accumulated counters, checkpointed to EEPROM
+struct OperatingCounters {
+    uint32_t runSeconds;                      // Time any axis spent starting, running or stopping
+    uint32_t ampSeconds;                      // Integrated motor current
+    uint32_t energyJoules;                    // Estimated energy drawn from supply
+    uint32_t starts;                          // Number of motor starts
+    uint32_t bandSeconds[SPEED_BAND_COUNT];   // Run time per speed band
+};
+
+extern OperatingCounters operatingCounters;
+
+// Function declarations
+void initializeCounters();
+void updateCounters();
+void serviceCounters();
+void printCounters(Print& out);
+
+#endif
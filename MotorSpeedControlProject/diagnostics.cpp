@@ -0,0 +1,71 @@
+/*
+ * Diagnostics implementation for DC Motor Speed Control Project
+ */
+
+#include "diagnostics.h"
+#include "watchdog.h"  // For getResetCause()
+
+// Linker symbols: end of static data, and end of the heap if malloc() is used
+extern char __heap_start;
+extern char* __brkval;
+
+static uint8_t* paintBottom = NULL;   // First painted byte
+static uint8_t* stackLowest = NULL;   // Lowest byte the stack has reached
+
+uint8_t* staticRamEnd() {
+    return (uint8_t*)(__brkval ? __brkval : &__heap_start);
+}
+
+// Fill the free RAM below the stack with the pattern; not inlined so that
+// SP here is below the frame of setup()
+void __attribute__((noinline)) paintFreeRam() {
+    uint8_t* top = (uint8_t*)(uintptr_t)SP;
+
+    paintBottom = staticRamEnd();
+    for (uint8_t* p = paintBottom; p < top; p++) {
+        *p = STACK_PAINT_PATTERN;
+    }
+    stackLowest = top;
+}
+
+// Scan up from the bottom for the first overwritten byte; the cost grows
+// with the free RAM, so this runs on demand only
+void checkStack() {
+    uint8_t* p = paintBottom;
+
+    if (p == NULL) {
+        return;
+    }
+    while (p < stackLowest && *p == STACK_PAINT_PATTERN) {
+        p++;
+    }
+    stackLowest = p;
+}
+
+uint16_t getStaticRam() {
+    return staticRamEnd() - (uint8_t*)RAMSTART;
+}
+
+uint16_t getStackPeak() {
+    checkStack();
+    return (uint8_t*)RAMEND + 1 - stackLowest;
+}
+
+uint16_t getFreeRamMin() {
+    checkStack();
+    return stackLowest - paintBottom;
+}
+
+// Print RAM use and boot diagnostics as key=value lines
+void printDiagnostics(Print& out) {
+    out.print(F("ram_total="));
+    out.println(RAMEND + 1 - RAMSTART);
+    out.print(F("ram_static="));
+    out.println(getStaticRam());
+    out.print(F("stack_peak="));
+    out.println(getStackPeak());
+    out.print(F("ram_free_min="));
+    out.println(getFreeRamMin());
+    out.print(F("reset_cause="));
+    out.println(getResetTypeText(getResetCause()));
+}
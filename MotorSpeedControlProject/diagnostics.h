@@ -0,0 +1,29 @@
+/*
+ * Diagnostics declarations for DC Motor Speed Control Project
+ *
+ * RAM headroom is tracked by stack painting: at boot the free RAM between
+ * the end of the static data (.data, .bss and heap) and the stack is filled
+ * with a pattern, and the lowest overwritten byte marks the deepest stack
+ * use so far. Static RAM per module is reported at build time by
+ * tools/ram_report.sh.
+ */
+
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+
+const uint8_t STACK_PAINT_PATTERN = 0xC5;
+
+// Function declarations
+void paintFreeRam();             // Call first thing in setup()
+void checkStack();               // Update the stack high-water mark
+uint16_t getStaticRam();         // .data, .bss and heap in bytes
+uint8_t* staticRamEnd();         // First byte above .bss and the heap
+uint16_t getStackPeak();         // Deepest stack use in bytes
+uint16_t getFreeRamMin();        // Free RAM left at the deepest stack use
+void printDiagnostics(Print& out);
+
+#endif
@@ -9,6 +9,22 @@
 #include "pins.h"
 #include "alarms.h"  // For getAlarmText()
 #include "logo.h"    // For logo bitmap
+#include "event_log.h"  // For event log page
+#include "counters.h"   // For counters page
+#include "utils.h"      // For printFixed()
+#include "trend.h"      // For trend samples
+#include "scaling.h"    // For inputScaling
+#include "axis.h"       // For activeAxis()
+#include "speed_sync.h" // For the follower reference
+#include "watchdog.h"   // For isWarmReset()
+#include "diagnostics.h" // For diagnostics page
+#include "program.h"     // For the program status
+#include "setpoint.h"    // For the setpoint source
+
+// Adaptive refresh state
+static DisplayPower displayPower = DISPLAY_ON;
+static unsigned long lastDisplayActivity = 0;  // Last button press
+static unsigned long lastDisplayChange = 0;    // Last change of the shown values
 
 // Initialize display
 void initializeDisplay() {
@@ -16,64 +32,88 @@ void initializeDisplay() {
     u8g2.setFont(u8g2_font_6x10_tf);
     u8g2.setDrawColor(1);
     u8g2.setFontPosTop();
+    u8g2.setContrast(DISPLAY_CONTRAST_NORMAL);
+    lastDisplayActivity = millis();
 }
 
-// Show splash screen
-void showSplashScreen() {
-    u8g2.clearBuffer();
-    
-    // Draw full screen logo
+// Splash screen state
+static bool splashActive = false;
+static unsigned long splashStartTime = 0;
 
+// Show splash screen without blocking; updateDisplay() holds it for
+// SPLASH_DISPLAY_TIME. Skipped on warm reset, where the reset cause is shown.
+void showSplashScreen() {
+    if (isWarmReset()) {
+        return;
+    }
 
-        // Calcola la posizione per centrare l'immagine
-        int x = (u8g2.getDisplayWidth() - 64) / 2;
-        int y = (u8g2.getDisplayHeight() - 64) / 2;
+    u8g2.clearBuffer();
 
+    // Centre the logo
+    int x = (u8g2.getDisplayWidth() - 64) / 2;
+    int y = (u8g2.getDisplayHeight() - 64) / 2;
+    drawLogo(x, y);
 
-    drawLogo(x, y);  // Logo occupa tutto lo schermo
-    
     u8g2.sendBuffer();
-    delay(2000);  // Mostra il logo per 2 secondi
+    splashActive = true;
+    splashStartTime = millis();
 }
 
 // Global variables for message handling
-static char currentMessage[32] = "";
+static const __FlashStringHelper* currentMessage = NULL;
 static unsigned long messageStartTime = 0;
 static bool messageActive = false;
 
 // Global variables for popup handling
-static char popupTitle[16] = "";
-static char popupMessage[32] = "";
+static const __FlashStringHelper* popupTitle = NULL;
+static const __FlashStringHelper* popupMessage = NULL;
 bool popupActive = false;
 bool popupNeedsConfirmation = false;
 static unsigned long popupStartTime = 0;
 
+// Trend screen state
+static bool trendView = false;
+static bool trendValid = false;           // Plot area of the buffer holds the trend
+static uint16_t trendDrawnSequence = 0;   // Last sample drawn
+
 void clearDisplay() {
     u8g2.clearBuffer();
     u8g2.sendBuffer();
 }
 
-void showMessage(const char* message) {
-    strncpy(currentMessage, message, sizeof(currentMessage) - 1);
+// Draw a flash string at x, y
+void drawText(uint8_t x, uint8_t y, const __FlashStringHelper* text) {
+    u8g2.setCursor(x, y);
+    u8g2.print(text);
+}
+
+// Draw a fixed-point number at x, y, right-aligned to width characters
+void drawFixed(uint8_t x, uint8_t y, int32_t value, uint8_t decimals, uint8_t width) {
+    u8g2.setCursor(x, y);
+    printFixed(u8g2, value, decimals, width);
+}
+
+void showMessage(const __FlashStringHelper* message) {
+    currentMessage = message;
     messageStartTime = millis();
     messageActive = true;
 }
 
-void showPopup(const char* title, const char* message, bool needConfirmation) {
-    strncpy(popupTitle, title, sizeof(popupTitle) - 1);
-    strncpy(popupMessage, message, sizeof(popupMessage) - 1);
+void showPopup(const __FlashStringHelper* title, const __FlashStringHelper* message, bool needConfirmation) {
+    popupTitle = title;
+    popupMessage = message;
     popupActive = true;
     popupNeedsConfirmation = needConfirmation;
     popupStartTime = millis();
     
     // Draw popup box - dimensioni ridotte per display 64px
     u8g2.drawFrame(10, 5, 108, 34);  // Ridotto da 44 a 34 pixel in altezza
-    u8g2.drawStr(12, 7, popupTitle);
+    drawText(12, 7, popupTitle);
     u8g2.drawHLine(10, 17, 108);
-    u8g2.drawStr(12, 19, popupMessage);
+    drawText(12, 19, popupMessage);
     
     if (popupNeedsConfirmation) {
-        u8g2.drawStr(12, 31, "Press ENTER to continue");
+        drawText(12, 31, F("Press ENTER to continue"));
     }
 }
 
@@ -88,24 +128,131 @@ void handleDisplayError() {
     digitalWrite(RGB_BLUE_PIN, LOW);
 }
 
+// Set the panel brightness or switch it off
+static void setDisplayPower(DisplayPower power) {
+    if (power == displayPower) {
+        return;
+    }
+    u8g2.setPowerSave(power == DISPLAY_BLANKED);
+    u8g2.setContrast(power == DISPLAY_DIMMED ? DISPLAY_CONTRAST_DIM : DISPLAY_CONTRAST_NORMAL);
+    displayPower = power;
+}
+
+// Record a button press. Returns true if the display was dimmed or blank,
+// in which case the press only wakes it up.
+bool wakeDisplay() {
+    bool wasAsleep = displayPower != DISPLAY_ON;
+
+    lastDisplayActivity = millis();
+    setDisplayPower(DISPLAY_ON);
+    return wasAsleep;
+}
+
+// True if any value shown on the main screen moved past its dead band
+static bool displayedValuesChanged() {
+    static uint16_t shownSpeed, shownCurrent, shownSetpoint;
+    static uint8_t shownAxis, shownState;
+    const MotorAxis& axis = activeAxis();
+    uint16_t setpoint = axis.pidSetpoint;
+
+    if (abs((int32_t)axis.speed - shownSpeed) < DISPLAY_CHANGE_SPEED &&
+        abs((int32_t)axis.milliAmps - shownCurrent) < DISPLAY_CHANGE_CURRENT &&
+        setpoint == shownSetpoint && selectedAxis == shownAxis && axis.state == shownState) {
+        return false;
+    }
+    shownSpeed = axis.speed;
+    shownCurrent = axis.milliAmps;
+    shownSetpoint = setpoint;
+    shownAxis = selectedAxis;
+    shownState = axis.state;
+    return true;
+}
+
+// Refresh period and panel power from activity: fast while buttons are used
+// or values change, slow when stable, dimmed then blanked when unattended.
+// Alarms, messages and popups always keep the panel on.
+static unsigned long updateDisplayPower(unsigned long currentMillis) {
+    bool anyRunning = false;
+    bool anyAlarm = false;
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        anyRunning |= isMotorRunning(axes[i]);
+        anyAlarm |= axes[i].state == STATE_ALARM;
+    }
+    if (anyAlarm || popupActive || messageActive) {
+        lastDisplayActivity = currentMillis;
+    }
+
+    unsigned long idle = currentMillis - lastDisplayActivity;
+    if (idle >= DISPLAY_BLANK_TIME && !anyRunning) {
+        setDisplayPower(DISPLAY_BLANKED);
+    } else if (idle >= DISPLAY_DIM_TIME) {
+        setDisplayPower(DISPLAY_DIMMED);
+    } else {
+        setDisplayPower(DISPLAY_ON);
+    }
+
+    if (displayedValuesChanged()) {
+        lastDisplayChange = currentMillis;
+    }
+    if (idle < DISPLAY_ACTIVE_TIME || currentMillis - lastDisplayChange < DISPLAY_ACTIVE_TIME) {
+        return DISPLAY_FAST_INTERVAL;
+    }
+    return DISPLAY_IDLE_INTERVAL;
+}
+
 // Update the existing updateDisplay() to handle messages and popups
 void updateDisplay() {
     static unsigned long lastUpdate = 0;
+    static unsigned long lastCheck = 0;
     unsigned long currentMillis = millis();
     
-    if (currentMillis - lastUpdate >= DISPLAY_UPDATE_INTERVAL) {
+    // Hold the splash screen until it expires or something needs the display
+    if (splashActive) {
+        if (currentMillis - splashStartTime < SPLASH_DISPLAY_TIME &&
+            currentMenu == MENU_NONE && !popupActive && !messageActive &&
+            activeAxis().state != STATE_ALARM) {
+            return;
+        }
+        splashActive = false;
+    }
+
+    // Activity and panel power are checked at the fast rate
+    if (currentMillis - lastCheck < DISPLAY_FAST_INTERVAL) {
+        return;
+    }
+    lastCheck = currentMillis;
+    unsigned long interval = updateDisplayPower(currentMillis);
+    if (displayPower == DISPLAY_BLANKED) {
+        return;  // Nothing to draw on a blank panel
+    }
+
+    if (currentMillis - lastUpdate >= interval) {
+        if (messageActive && currentMillis - messageStartTime >= MESSAGE_DISPLAY_TIME) {
+            messageActive = false;
+        }
+
+        // The trend screen keeps its plot in the buffer between refreshes
+        if (trendView && currentMenu == MENU_NONE && !popupActive && !messageActive) {
+            drawTrendScreen();
+            u8g2.sendBuffer();
+            lastUpdate = currentMillis;
+            return;
+        }
+        trendValid = false;
+
         u8g2.clearBuffer();
         
         // Check for active popup
         if (popupActive) {
             // Draw popup box
             u8g2.drawFrame(10, 10, 108, 44);
-            u8g2.drawStr(12, 12, popupTitle);
+            drawText(12, 12, popupTitle);
             u8g2.drawHLine(10, 22, 108);
-            u8g2.drawStr(12, 24, popupMessage);
+            drawText(12, 24, popupMessage);
             
             if (popupNeedsConfirmation) {
-                u8g2.drawStr(12, 36, "Press ENTER");
+                drawText(12, 36, F("Press ENTER"));
             } else if (currentMillis - popupStartTime >= POPUP_TIMEOUT) {
                 popupActive = false;
             }
@@ -117,57 +264,20 @@ void updateDisplay() {
         
         // Check for active message
         if (messageActive) {
-            if (currentMillis - messageStartTime >= MESSAGE_DISPLAY_TIME) {
-                messageActive = false;
-            } else {
-                u8g2.drawStr(0, HEADER_HEIGHT, currentMessage);
-                u8g2.sendBuffer();
-                lastUpdate = currentMillis;
-                return;
-            }
+            drawText(0, HEADER_HEIGHT, currentMessage);
+            u8g2.sendBuffer();
+            lastUpdate = currentMillis;
+            return;
         }
         
         // Normal display update
-        // Draw header with system state
-        u8g2.setFont(u8g2_font_6x10_tf);
-        u8g2.drawStr(0, 0, "Status:");
-        switch(currentState) {
-            case STATE_IDLE:
-                u8g2.drawStr(50, 0, "IDLE");
-                break;
-            case STATE_RUN:
-                u8g2.drawStr(50, 0, "RUNNING");
-                break;
-            case STATE_ALARM:
-                u8g2.drawStr(50, 0, getAlarmText());
-                break;
-        }
+        drawHeader();
         
         // If in menu mode, show menu
         if (currentMenu != MENU_NONE) {
             drawMenuScreen();
         } else {
-            // Show main operating screen
-            char buffer[20];
-            
-            // Show current speed
-            snprintf(buffer, sizeof(buffer), "Speed: %d RPM", (int)currentSpeed);
-            u8g2.drawStr(0, MENU_START_Y, buffer);
-            
-            // Show current current
-            int int_part = (int)currentCurrent;                      
-            int decimal_part = (int)((currentCurrent - int_part) * 10);
-            if (decimal_part < 0) decimal_part = -decimal_part;    
-            snprintf(buffer, sizeof(buffer), "Current: %d.%d A", int_part, decimal_part);
-            u8g2.drawStr(0, MENU_START_Y + LINE_HEIGHT, buffer);
-            
-            // Show setpoint and pwm if running
-            if (currentState == STATE_RUN) {
-                snprintf(buffer, sizeof(buffer), "PWM: %d", (int)pidOutput);
-                u8g2.drawStr(0, MENU_START_Y + LINE_HEIGHT * 2, buffer);
-                snprintf(buffer, sizeof(buffer), "Set: %d RPM", (int)pidSetpoint);
-                u8g2.drawStr(0, MENU_START_Y + LINE_HEIGHT * 3, buffer);
-            }
+            drawMainScreen();
         }
         
         u8g2.sendBuffer();
@@ -175,21 +285,98 @@ void updateDisplay() {
     }
 }
 
-void updateLedBar() {
-    static unsigned long lastUpdate = 0;
-    unsigned long currentMillis = millis();
+// Draw main operating screen, values right-aligned
+void drawMainScreen() {
+    const MotorAxis& axis = activeAxis();
+    uint8_t y = MENU_START_Y;
+
+    // Show current speed
+    drawText(0, y, F("Speed:"));
+    drawFixed(READOUT_X, y, axis.speed, 0, READOUT_WIDTH);
+    drawText(UNIT_X, y, F("RPM"));
     
-    // Update LED bar only at specified intervals
-    if (currentMillis - lastUpdate >= LED_BAR_UPDATE_INTERVAL) {
-        // Map current speed to LED bar range
-        int ledCount = map(currentSpeed, 0, systemParams.speedFullScale, 0, LED_BAR_COUNT);
-        
-        // Update each LED
-        for(uint8_t i = 0; i < LED_BAR_COUNT; i++) {
-            digitalWrite(LED_BAR_PINS[i], i < ledCount ? HIGH : LOW);
+    // Show current current, rounded to 0.1 A
+    y += LINE_HEIGHT;
+    drawText(0, y, F("Current:"));
+    drawFixed(READOUT_X, y, (axis.milliAmps + 50) / 100, 1, READOUT_WIDTH);
+    drawText(UNIT_X, y, F("A"));
+    
+    // Show setpoint and pwm if running
+    if (isMotorRunning(axis)) {
+        y += LINE_HEIGHT;
+        drawText(0, y, F("PWM:"));
+        drawFixed(READOUT_X, y, axis.pwm, 0, READOUT_WIDTH);
+        y += LINE_HEIGHT;
+        SetpointSource source = getSetpointSource(axis);
+        drawText(0, y, source == SOURCE_LOCAL ? F("Set:") : getSetpointSourceText(source));
+        drawFixed(READOUT_X, y, (int32_t)axis.pidSetpoint, 0, READOUT_WIDTH);
+        drawText(UNIT_X, y, F("RPM"));
+    }
+
+    // Show the master reference when following
+    if (systemParams.syncMode == SYNC_FOLLOWER) {
+        y += LINE_HEIGHT;
+        drawText(0, y, F("Ref:"));
+        if (isReferenceLost()) {
+            drawText(READOUT_X, y, F("  LOST"));
+        } else {
+            drawFixed(READOUT_X, y, getSyncReference(), 0, READOUT_WIDTH);
+            drawText(UNIT_X, y, F("RPM"));
+        }
+    }
+
+    // Show the program step, e.g. "Prg: 3/7 HOLD 12s"
+    ProgramStatus program = getProgramStatus();
+    if (program == PROGRAM_STARTING || program == PROGRAM_RUNNING) {
+        y += LINE_HEIGHT;
+        drawText(0, y, F("Prg:"));
+        u8g2.setCursor(30, y);
+        if (program == PROGRAM_STARTING) {
+            u8g2.print(getProgramStatusText());
+        } else {
+            u8g2.print(getProgramStep() + 1);
+            u8g2.print('/');
+            u8g2.print(getProgramLength());
+            u8g2.print(' ');
+            u8g2.print(getProgramOpText(getProgramStepOp()));
+            uint16_t remaining = getProgramRemaining();
+            if (remaining > 0) {
+                u8g2.print(' ');
+                u8g2.print(remaining);
+                u8g2.print('s');
+            }
         }
-        
-        lastUpdate = currentMillis;
+    }
+}
+
+// Draw header with system state
+void drawHeader() {
+    u8g2.setFont(u8g2_font_6x10_tf);
+    drawText(0, 0, F("Status:"));
+    switch(activeAxis().state) {
+        case STATE_IDLE:
+            drawText(50, 0, F("IDLE"));
+            break;
+        case STATE_RUN:
+            drawText(50, 0, F("RUNNING"));
+            break;
+        case STATE_STARTING:
+            drawText(50, 0, F("STARTING"));
+            break;
+        case STATE_STOPPING:
+            drawText(50, 0, F("STOPPING"));
+            break;
+        case STATE_ALARM:
+            drawText(50, 0, getAlarmText());
+            break;
+        default:
+            drawText(50, 0, F("---"));
+            break;
+    }
+
+    // Selected axis number
+    if (AXIS_COUNT > 1) {
+        drawFixed(u8g2.getDisplayWidth() - 6, 0, selectedAxis + 1);
     }
 }
 
@@ -198,116 +385,113 @@ void drawMenuScreen() {
     u8g2.setFont(u8g2_font_6x10_tf);
     
     switch(currentMenu) {
+        case MENU_EVENT_LOG:
+            drawEventLogScreen();
+            break;
 
-        case MENU_MAIN:
-            if (currentState == STATE_RUN) {
-                drawMenuItem("Stop", ITEM_STOP, MENU_START_Y);
-            } else {
-                drawMenuItem("Run", ITEM_RUN, MENU_START_Y);
-            }
-            drawMenuItem("Settings", ITEM_SETTINGS, MENU_START_Y + LINE_HEIGHT);
-            drawMenuItem("Back", ITEM_BACK, MENU_START_Y + LINE_HEIGHT * 2);
+        case MENU_COUNTERS:
+            drawCountersScreen();
             break;
 
-        case MENU_SETTINGS:
-            {
-                char buffer[20];
-                // Mostriamo solo 3 voci alla volta invece di 4
-                int int_part = (int)systemParams.currentFullScale;                      
-                int decimal_part = (int)((systemParams.currentFullScale - int_part) * 10);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "Curr. FS: %d.%dA", int_part, decimal_part);
-                drawMenuItem(buffer, ITEM_CURRENT_FS, MENU_START_Y);
-                
-                snprintf(buffer, sizeof(buffer), "Speed FS: %dRPM", systemParams.speedFullScale);
-                drawMenuItem(buffer, ITEM_SPEED_FS, MENU_START_Y + LINE_HEIGHT);
-                
-                drawMenuItem("PID Settings", ITEM_PID_P, MENU_START_Y + LINE_HEIGHT * 2);
-            }
+        case MENU_DIAGNOSTICS:
+            drawDiagnosticsScreen();
             break;
-            
-        case MENU_PID:
-            {
-                char buffer[20];
-                int int_part, decimal_part;
-
-                int_part = (int)systemParams.kp;                      
-                decimal_part = (int)((systemParams.kp - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "Kp:       %d.%02d", int_part, decimal_part);
-                drawMenuItem(buffer, ITEM_PID_P, MENU_START_Y);
-                
-                int_part = (int)systemParams.ki;                      
-                decimal_part = (int)((systemParams.ki - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "Ki:       %d.%02d", int_part, decimal_part);
-                drawMenuItem(buffer, ITEM_PID_I, MENU_START_Y + LINE_HEIGHT);
-                
-                int_part = (int)systemParams.kd;                      
-                decimal_part = (int)((systemParams.kd - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "Kd:       %d.%02d", int_part, decimal_part);
-                drawMenuItem(buffer, ITEM_PID_D, MENU_START_Y + LINE_HEIGHT * 2);
-            }
+
+        default:
+            drawMenuList();
             break;
     }
 }
 
-// Draw single menu item
-void drawMenuItem(const char* text, MenuItem item, uint8_t y) {
+// Draw the entries of the current page, scrolled to keep the selection visible
+void drawMenuList() {
+    MenuItem items[MENU_MAX_PAGE_ITEMS];
+    uint8_t count = getMenuPageItems(currentMenu, items);
+    uint8_t first = 0;
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (items[i] == selectedItem && i >= MENU_VISIBLE_ROWS) {
+            first = i - MENU_VISIBLE_ROWS + 1;
+        }
+    }
+
+    for (uint8_t row = 0; row < MENU_VISIBLE_ROWS && first + row < count; row++) {
+        drawMenuItem(items[first + row], MENU_START_Y + LINE_HEIGHT * row);
+    }
+}
+
+// Draw event log page: a few entries and the details of the first one
+void drawEventLogScreen() {
+    EventLogEntry entry;
+
+    if (getEventLogCount() == 0) {
+        drawText(10, MENU_START_Y, F("No events"));
+        return;
+    }
+
+    for (uint8_t row = 0; row < EVENT_LOG_ROWS; row++) {
+        if (!readEventLogEntry(eventLogView + row, entry)) {
+            break;
+        }
+        drawFixed(10, MENU_START_Y + LINE_HEIGHT * row, entry.uptime);
+        u8g2.print(F("s "));
+        printEventText(u8g2, entry);
+    }
+
+    // Details of the selected entry
+    if (readEventLogEntry(eventLogView, entry)) {
+        drawText(0, MENU_START_Y, F(">"));
+        drawFixed(10, MENU_START_Y + LINE_HEIGHT * EVENT_LOG_ROWS, entry.current, 1);
+        u8g2.print(F("A "));
+        u8g2.print(entry.speed);
+        u8g2.print(F("RPM"));
+    }
+}
+
+// Draw diagnostics page: RAM headroom, loop timing and reset cause
+void drawDiagnosticsScreen() {
+    drawText(0, MENU_START_Y, F("Static"));
+    drawFixed(READOUT_X, MENU_START_Y, getStaticRam(), 0, READOUT_WIDTH);
+    drawText(UNIT_X, MENU_START_Y, F("B"));
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT, F("Stack max"));
+    drawFixed(READOUT_X, MENU_START_Y + LINE_HEIGHT, getStackPeak(), 0, READOUT_WIDTH);
+    drawText(UNIT_X, MENU_START_Y + LINE_HEIGHT, F("B"));
 
-int int_part;
-int decimal_part;
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 2, F("Free min"));
+    drawFixed(READOUT_X, MENU_START_Y + LINE_HEIGHT * 2, getFreeRamMin(), 0, READOUT_WIDTH);
+    drawText(UNIT_X, MENU_START_Y + LINE_HEIGHT * 2, F("B"));
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 3, F("Loop max"));
+    drawFixed(READOUT_X, MENU_START_Y + LINE_HEIGHT * 3, getLongestLoop(), 0, READOUT_WIDTH);
+    drawText(UNIT_X, MENU_START_Y + LINE_HEIGHT * 3, F("ms"));
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 4, getResetCauseText(getResetCause()));
+}
+
+// Draw single menu item: label from the entry table, value from its parameter
+void drawMenuItem(MenuItem item, uint8_t y) {
+    MenuEntry entry;
+
+    getMenuEntry(item, entry);
 
     // Draw selection indicator
     if (selectedItem == item) {
-        u8g2.drawStr(0, y, ">");
+        drawText(0, y, F(">"));
         
         // Draw edit indicator if editing
         if (editingValue) {
-            u8g2.drawStr(VALUE_X - 10, y, "*");
+            drawText(VALUE_X - 10, y, F("*"));
         }
     }
     
     // Draw menu item text
-    u8g2.drawStr(10, y, text);
+    drawText(10, y, FPSTR(entry.label));
     
-    // If editing this item, draw value with edit indicator
-    if (editingValue && selectedItem == item) {
-        char buffer[10];
-        switch(item) {
-            case ITEM_CURRENT_FS:
-                int_part = (int)systemParams.currentFullScale;                      
-                decimal_part = (int)((systemParams.currentFullScale - int_part) * 10);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "%d.%d", int_part, decimal_part);
-                break;
-            case ITEM_SPEED_FS:
-                snprintf(buffer, sizeof(buffer), "%d", systemParams.speedFullScale);
-                break;
-            case ITEM_PID_P:
-                int_part = (int)systemParams.kp;                      
-                decimal_part = (int)((systemParams.kp - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "%d.%02d", int_part, decimal_part);
-                break;
-            case ITEM_PID_I:
-                int_part = (int)systemParams.ki;                      
-                decimal_part = (int)((systemParams.ki - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "%d.%02d", int_part, decimal_part);
-                break;
-            case ITEM_PID_D:
-                int_part = (int)systemParams.kd;                      
-                decimal_part = (int)((systemParams.kd - int_part) * 100);
-                if (decimal_part < 0) decimal_part = -decimal_part;    
-                snprintf(buffer, sizeof(buffer), "%d.%02d", int_part, decimal_part);
-                break;
-            default:
-                buffer[0] = '\0';
-                break;
-        }
-        u8g2.drawStr(VALUE_X, y, buffer);
+    // Draw bound parameter value
+    if (entry.action == ACTION_EDIT) {
+        u8g2.setCursor(VALUE_X, y);
+        printParamValue(u8g2, entry.arg);
     }
 }
 
@@ -315,3 +499,108 @@ void drawLogo(uint8_t x, uint8_t y)
 {
     Logo();
 }
+
+// Draw operating counters page
+void drawCountersScreen() {
+    uint32_t total = 0;
+    uint8_t minutes = operatingCounters.runSeconds / 60 % 60;
+
+    drawText(0, MENU_START_Y, F("Run: "));
+    u8g2.print(operatingCounters.runSeconds / 3600);
+    u8g2.print(minutes < 10 ? F("h 0") : F("h "));
+    u8g2.print(minutes);
+    u8g2.print('m');
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT, F("Starts: "));
+    u8g2.print(operatingCounters.starts);
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 2, F("Charge: "));
+    u8g2.print(operatingCounters.ampSeconds / 3600);
+    u8g2.print(F("Ah"));
+
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 3, F("Energy: "));
+    u8g2.print(operatingCounters.energyJoules / 3600);
+    u8g2.print(F("Wh"));
+
+    // Share of run time per speed band
+    for (uint8_t i = 0; i < SPEED_BAND_COUNT; i++) {
+        total += operatingCounters.bandSeconds[i];
+    }
+    drawText(0, MENU_START_Y + LINE_HEIGHT * 4, F("Band%"));
+    for (uint8_t i = 0; i < SPEED_BAND_COUNT; i++) {
+        uint8_t percent = total ? operatingCounters.bandSeconds[i] * 100ULL / total : 0;
+        drawFixed(36 + i * 22, MENU_START_Y + LINE_HEIGHT * 4, percent);
+    }
+}
+
+// Switch the main screen between values and trend
+// Redraw everything on the next refresh, after the buffer was used elsewhere
+void invalidateDisplay() {
+    trendValid = false;
+}
+
+void toggleTrendView() {
+    trendView = !trendView;
+    trendValid = false;
+}
+
+// Draw one trend column: speed as a line joined to the previous sample,
+// setpoint dashed, current as a filled area
+static void drawTrendColumn(uint8_t x, const TrendSample& sample,
+                            const TrendSample* previous, uint16_t sequence) {
+    const uint8_t speedBottom = TREND_TOP + TREND_SPEED_HEIGHT - 1;
+    const uint8_t currentBottom = speedBottom + TREND_CURRENT_HEIGHT;
+    uint8_t low = sample.speed;
+    uint8_t high = sample.speed;
+
+    if (previous != NULL) {
+        low = min(low, previous->speed);
+        high = max(high, previous->speed);
+    }
+    u8g2.drawVLine(x, speedBottom - high, high - low + 1);
+
+    if ((sequence & 1) && sample.setpoint > 0) {
+        u8g2.drawPixel(x, speedBottom - sample.setpoint);
+    }
+
+    u8g2.drawVLine(x, currentBottom - sample.current, sample.current + 1);
+}
+
+// Draw trend screen. The plot is scrolled in the display buffer and only
+// the columns of new samples are drawn; it is redrawn from the recorder
+// when another screen has used the buffer.
+void drawTrendScreen() {
+    uint8_t* buffer = u8g2.getBufferPtr();
+    const uint8_t width = u8g2.getDisplayWidth();
+    const uint8_t firstPage = TREND_TOP / 8;
+    const uint8_t pages = u8g2.getBufferTileHeight();
+    uint16_t sequence = getTrendSequence();
+    uint16_t newSamples = sequence - trendDrawnSequence;
+    TrendSample sample, previous;
+
+    // Header rows are redrawn every time
+    memset(buffer, 0, firstPage * width);
+    drawHeader();
+
+    if (!trendValid || newSamples >= width) {
+        memset(buffer + firstPage * width, 0, (pages - firstPage) * width);
+        newSamples = width;
+        trendValid = true;
+    } else if (newSamples > 0) {
+        // Scroll the plot left by one column per new sample
+        for (uint8_t page = firstPage; page < pages; page++) {
+            uint8_t* row = buffer + page * width;
+            memmove(row, row + newSamples, width - newSamples);
+            memset(row + width - newSamples, 0, newSamples);
+        }
+    }
+
+    for (uint8_t age = newSamples; age-- > 0; ) {
+        if (!readTrendSample(age, sample)) {
+            continue;
+        }
+        bool hasPrevious = readTrendSample(age + 1, previous);
+        drawTrendColumn(width - 1 - age, sample, hasPrevious ? &previous : NULL, sequence - age);
+    }
+    trendDrawnSequence = sequence;
+}
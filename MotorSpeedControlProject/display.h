@@ -15,24 +15,56 @@ const uint8_t HEADER_HEIGHT = 10;
 const uint8_t LINE_HEIGHT = 8;
 const uint8_t MENU_START_Y = 12;
 const uint8_t VALUE_X = 70;
+const uint8_t READOUT_X = 54;      // Main screen values, right-aligned
+const uint8_t READOUT_WIDTH = 6;   // Characters per main screen value
+const uint8_t UNIT_X = 96;
+const uint8_t EVENT_LOG_ROWS = 4;  // Event log entries per page
+const uint8_t MENU_VISIBLE_ROWS = 6;  // Menu entries per screen
+const uint8_t TREND_TOP = 16;         // First trend plot row, page aligned
+
+// Adaptive refresh: changes that count as activity, and panel brightness
+const uint16_t DISPLAY_CHANGE_SPEED = 10;      // RPM
+const uint16_t DISPLAY_CHANGE_CURRENT = 100;   // mA
+const uint8_t DISPLAY_CONTRAST_NORMAL = 255;
+const uint8_t DISPLAY_CONTRAST_DIM = 8;
+
+// Panel power states
+enum DisplayPower {
+    DISPLAY_ON,
+    DISPLAY_DIMMED,
+    DISPLAY_BLANKED
+};
 
 // Message display timing
 const unsigned long MESSAGE_DISPLAY_TIME = 2000;  // 2 seconds
+const unsigned long SPLASH_DISPLAY_TIME = 2000;   // 2 seconds, not blocking
 const unsigned long POPUP_TIMEOUT = 5000;        // 5 seconds
 
 // Function declarations
 void initializeDisplay();
 void showSplashScreen();
 void updateDisplay();
-void updateLedBar();
+void drawMainScreen();
 void drawMenuScreen();
-void drawMenuItem(const char* text, MenuItem item, uint8_t y);
+void drawMenuList();
+void drawMenuItem(MenuItem item, uint8_t y);
+void drawEventLogScreen();
+void drawCountersScreen();
+void drawDiagnosticsScreen();
+void drawHeader();
+void drawTrendScreen();
+void toggleTrendView();
+void invalidateDisplay();
+bool wakeDisplay();
 void drawLogo(uint8_t x, uint8_t y);
 
 // New functions
 void clearDisplay();
-void showMessage(const char* message);
-void showPopup(const char* title, const char* message, bool needConfirmation = false);
+void showMessage(const __FlashStringHelper* message);
+void showPopup(const __FlashStringHelper* title, const __FlashStringHelper* message,
+               bool needConfirmation = false);
+void drawText(uint8_t x, uint8_t y, const __FlashStringHelper* text);
+void drawFixed(uint8_t x, uint8_t y, int32_t value, uint8_t decimals = 0, uint8_t width = 0);
 bool isDisplayError();
 void handleDisplayError();
 
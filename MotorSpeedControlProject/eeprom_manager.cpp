@@ -4,6 +4,11 @@
 
 #include "eeprom_manager.h"
 #include "globals.h"
+#include "scaling.h"  // For updateScaling()
+#include "speed_sync.h"  // For SYNC_TRIM_LIMIT
+#include "filters.h"     // For FILTER_IIR_SHIFT_MAX
+#include "led_bar.h"     // For LedBarMode
+#include "setpoint.h"    // For SETPOINT_SOURCE_MAX
 
 // Function to check if EEPROM contains valid data
 bool isEEPROMValid() {
@@ -12,6 +17,17 @@ bool isEEPROMValid() {
     return storedKey == EEPROM_VALID_KEY;
 }
 
+// Check if a stored value is still erased (all bytes 0xFF), as the cells of
+// a parameter added by a firmware update are on the first boot after it
+static bool isErased(int address, uint8_t size) {
+    for (uint8_t i = 0; i < size; i++) {
+        if (EEPROM.read(address + i) != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Function to initialize EEPROM with default values
 void initializeEEPROM() {
     // Write validation key
@@ -23,6 +39,16 @@ void initializeEEPROM() {
     systemParams.kp = DEFAULT_KP;
     systemParams.ki = DEFAULT_KI;
     systemParams.kd = DEFAULT_KD;
+    systemParams.stopMode = DEFAULT_STOP_MODE;
+    systemParams.syncMode = DEFAULT_SYNC_MODE;
+    systemParams.syncRatio = DEFAULT_SYNC_RATIO;
+    systemParams.syncTrim = DEFAULT_SYNC_TRIM;
+    systemParams.speedFilter = DEFAULT_SPEED_FILTER;
+    systemParams.currentFilter = DEFAULT_CURRENT_FILTER;
+    systemParams.ledBarMode = DEFAULT_LED_BAR_MODE;
+    systemParams.setpointSource = DEFAULT_SETPOINT_SOURCE;
+    systemParams.plantGain = DEFAULT_PLANT_GAIN;
+    systemParams.plantTau = DEFAULT_PLANT_TAU;
     
     saveParameters();
 }
@@ -35,6 +61,16 @@ void loadParameters() {
     EEPROM.get(EEPROM_KP_ADDR, systemParams.kp);
     EEPROM.get(EEPROM_KI_ADDR, systemParams.ki);
     EEPROM.get(EEPROM_KD_ADDR, systemParams.kd);
+    EEPROM.get(EEPROM_STOP_MODE_ADDR, systemParams.stopMode);
+    EEPROM.get(EEPROM_SYNC_MODE_ADDR, systemParams.syncMode);
+    EEPROM.get(EEPROM_SYNC_RATIO_ADDR, systemParams.syncRatio);
+    EEPROM.get(EEPROM_SYNC_TRIM_ADDR, systemParams.syncTrim);
+    EEPROM.get(EEPROM_SPEED_FILTER_ADDR, systemParams.speedFilter);
+    EEPROM.get(EEPROM_CURRENT_FILTER_ADDR, systemParams.currentFilter);
+    EEPROM.get(EEPROM_LED_BAR_MODE_ADDR, systemParams.ledBarMode);
+    EEPROM.get(EEPROM_SETPOINT_SOURCE_ADDR, systemParams.setpointSource);
+    EEPROM.get(EEPROM_PLANT_GAIN_ADDR, systemParams.plantGain);
+    EEPROM.get(EEPROM_PLANT_TAU_ADDR, systemParams.plantTau);
     
     // Check if values are valid, if not load defaults
     if (isnan(systemParams.currentFullScale) || systemParams.currentFullScale <= 0) {
@@ -52,7 +88,39 @@ void loadParameters() {
     if (isnan(systemParams.kd)) {
         systemParams.kd = DEFAULT_KD;
     }
+    if (systemParams.stopMode > STOP_MODE_RAMP) {
+        systemParams.stopMode = DEFAULT_STOP_MODE;
+    }
+    if (systemParams.syncMode > SYNC_FOLLOWER) {
+        systemParams.syncMode = DEFAULT_SYNC_MODE;
+    }
+    if (isnan(systemParams.syncRatio) || systemParams.syncRatio <= 0) {
+        systemParams.syncRatio = DEFAULT_SYNC_RATIO;
+    }
+    // Erased reads as -1, which the menu cannot set in its 10 RPM steps
+    if (isErased(EEPROM_SYNC_TRIM_ADDR, sizeof(systemParams.syncTrim)) ||
+        systemParams.syncTrim < -SYNC_TRIM_LIMIT || systemParams.syncTrim > SYNC_TRIM_LIMIT) {
+        systemParams.syncTrim = DEFAULT_SYNC_TRIM;
+    }
+    if (systemParams.speedFilter > FILTER_IIR_SHIFT_MAX) {
+        systemParams.speedFilter = DEFAULT_SPEED_FILTER;
+    }
+    if (systemParams.currentFilter > FILTER_IIR_SHIFT_MAX) {
+        systemParams.currentFilter = DEFAULT_CURRENT_FILTER;
+    }
+    if (systemParams.ledBarMode > LED_BAR_ERROR) {
+        systemParams.ledBarMode = DEFAULT_LED_BAR_MODE;
+    }
+    if (systemParams.setpointSource > SETPOINT_SOURCE_MAX) {
+        systemParams.setpointSource = DEFAULT_SETPOINT_SOURCE;
+    }
+    if (isnan(systemParams.plantGain) || isnan(systemParams.plantTau) ||
+        systemParams.plantGain <= 0 || systemParams.plantTau <= 0) {
+        systemParams.plantGain = DEFAULT_PLANT_GAIN;
+        systemParams.plantTau = DEFAULT_PLANT_TAU;
+    }
     updatePIDParameters();
+    updateScaling();
 }
 
 // Save parameters to EEPROM
@@ -62,4 +130,14 @@ void saveParameters() {
     EEPROM.put(EEPROM_KP_ADDR, systemParams.kp);
     EEPROM.put(EEPROM_KI_ADDR, systemParams.ki);
     EEPROM.put(EEPROM_KD_ADDR, systemParams.kd);
+    EEPROM.put(EEPROM_STOP_MODE_ADDR, systemParams.stopMode);
+    EEPROM.put(EEPROM_SYNC_MODE_ADDR, systemParams.syncMode);
+    EEPROM.put(EEPROM_SYNC_RATIO_ADDR, systemParams.syncRatio);
+    EEPROM.put(EEPROM_SYNC_TRIM_ADDR, systemParams.syncTrim);
+    EEPROM.put(EEPROM_SPEED_FILTER_ADDR, systemParams.speedFilter);
+    EEPROM.put(EEPROM_CURRENT_FILTER_ADDR, systemParams.currentFilter);
+    EEPROM.put(EEPROM_LED_BAR_MODE_ADDR, systemParams.ledBarMode);
+    EEPROM.put(EEPROM_SETPOINT_SOURCE_ADDR, systemParams.setpointSource);
+    EEPROM.put(EEPROM_PLANT_GAIN_ADDR, systemParams.plantGain);
+    EEPROM.put(EEPROM_PLANT_TAU_ADDR, systemParams.plantTau);
 } 
\ No newline at end of file
@@ -0,0 +1,207 @@
+/*
+ * Event log implementation for DC Motor Speed Control Project
+ *
+ * Events are kept in a ring buffer in EEPROM. The ring head is found at boot
+ * from the rolling sequence numbers, so no index cell is rewritten on every
+ * event and wear is spread evenly over all slots. Logging only queues the
+ * entry in RAM: serviceEventLog() writes one byte per call from loop(), so
+ * an alarm never waits for the EEPROM.
+ */
+
+#include "event_log.h"
+#include <EEPROM.h>
+#include "globals.h"
+#include "utils.h"  // For printFixed()
+#include "watchdog.h"  // For getResetTypeText()
+
+static_assert(EEPROM_EVENT_LOG_ADDR + EVENT_LOG_SIZE * sizeof(EventLogEntry) <= EEPROM_COUNTERS_ADDR,
+              "The event log must end before the counters");
+
+// Ring state in EEPROM
+static uint8_t nextSlot = 0;      // Slot to be written next
+static uint8_t nextSequence = 0;  // Sequence number of the next entry
+static uint8_t storedCount = 0;   // Valid entries in EEPROM
+
+// Entries waiting to be written
+static EventLogEntry pendingEvents[EVENT_QUEUE_SIZE];
+static uint8_t pendingHead = 0;
+static uint8_t pendingCount = 0;
+static uint8_t pendingStep = 0;   // Write progress of the head entry
+
+// EEPROM address of a ring slot
+static int slotAddress(uint8_t slot) {
+    return EEPROM_EVENT_LOG_ADDR + slot * sizeof(EventLogEntry);
+}
+
+// Find the ring head from the stored sequence numbers
+void initializeEventLog() {
+    EventLogEntry entry, next;
+
+    nextSlot = 0;
+    nextSequence = 0;
+    storedCount = 0;
+
+    for (uint8_t slot = 0; slot < EVENT_LOG_SIZE; slot++) {
+        EEPROM.get(slotAddress(slot), entry);
+        if (entry.kind == EVENT_EMPTY) {
+            continue;
+        }
+        storedCount++;
+
+        // The newest entry is the one not followed by its successor
+        uint8_t nextIndex = (slot + 1) % EVENT_LOG_SIZE;
+        EEPROM.get(slotAddress(nextIndex), next);
+        if (next.kind == EVENT_EMPTY ||
+            next.sequence != (uint8_t)(entry.sequence + 1)) {
+            nextSlot = nextIndex;
+            nextSequence = entry.sequence + 1;
+        }
+    }
+
+    pendingHead = 0;
+    pendingCount = 0;
+    pendingStep = 0;
+}
+
+// Queue an entry for writing, dropping it if the queue is full
+static void queueEvent(const MotorAxis& axis, uint8_t kind, uint8_t detail) {
+    if (pendingCount >= EVENT_QUEUE_SIZE) {
+        return;
+    }
+
+    EventLogEntry& entry = pendingEvents[(pendingHead + pendingCount) % EVENT_QUEUE_SIZE];
+    entry.kind = kind | (getAxisIndex(axis) << EVENT_AXIS_SHIFT);
+    entry.detail = detail;
+    entry.current = axis.milliAmps / 100;
+    entry.speed = axis.speed;
+    entry.uptime = millis() / 1000;
+    pendingCount++;
+}
+
+void logAlarm(MotorAxis& axis, AlarmType alarm) {
+    queueEvent(axis, EVENT_ALARM, alarm);
+}
+
+void logStateChange(MotorAxis& axis, SystemState from, SystemState to) {
+    queueEvent(axis, EVENT_STATE_CHANGE, (from << 4) | (to & 0x0F));
+}
+
+void logReset(uint8_t cause) {
+    queueEvent(axes[0], EVENT_RESET, cause);
+}
+
+void logPlantDrift(MotorAxis& axis, uint8_t flags) {
+    queueEvent(axis, EVENT_PLANT_DRIFT, flags);
+}
+
+// Write at most one byte of the pending entry
+void serviceEventLog() {
+    if (pendingCount == 0) {
+        return;
+    }
+
+    EventLogEntry& entry = pendingEvents[pendingHead];
+    int address = slotAddress(nextSlot);
+
+    if (pendingStep == 0) {
+        // Keep tracking the peak current until the write starts
+        uint8_t axis = entry.kind >> EVENT_AXIS_SHIFT;
+        uint16_t current = axes[axis].milliAmps / 100;
+        if ((entry.kind & EVENT_KIND_MASK) == EVENT_ALARM && current > entry.current) {
+            entry.current = current;
+        }
+        entry.sequence = nextSequence;
+
+        // Invalidate the slot so a torn write is never read back
+        EEPROM.update(address, EVENT_EMPTY);
+    } else if (pendingStep < sizeof(EventLogEntry)) {
+        EEPROM.update(address + pendingStep, ((const uint8_t*)&entry)[pendingStep]);
+    } else {
+        // Commit the entry by writing its kind
+        EEPROM.update(address, entry.kind);
+
+        nextSlot = (nextSlot + 1) % EVENT_LOG_SIZE;
+        nextSequence++;
+        if (storedCount < EVENT_LOG_SIZE) {
+            storedCount++;
+        }
+        pendingHead = (pendingHead + 1) % EVENT_QUEUE_SIZE;
+        pendingCount--;
+        pendingStep = 0;
+        return;
+    }
+    pendingStep++;
+}
+
+// Erase all entries
+void clearEventLog() {
+    for (uint8_t slot = 0; slot < EVENT_LOG_SIZE; slot++) {
+        EEPROM.update(slotAddress(slot), EVENT_EMPTY);
+    }
+    nextSlot = 0;
+    nextSequence = 0;
+    storedCount = 0;
+    pendingCount = 0;
+    pendingStep = 0;
+}
+
+uint8_t getEventLogCount() {
+    return storedCount;
+}
+
+// Read a stored entry, index 0 is the newest
+bool readEventLogEntry(uint8_t index, EventLogEntry& entry) {
+    if (index >= storedCount) {
+        return false;
+    }
+    uint8_t slot = (nextSlot + EVENT_LOG_SIZE - 1 - index) % EVENT_LOG_SIZE;
+    EEPROM.get(slotAddress(slot), entry);
+    return entry.kind != EVENT_EMPTY;
+}
+
+// Print a short event description, e.g. "OVERCURRENT" or "IDLE>RUN"
+void printEventText(Print& out, const EventLogEntry& entry) {
+    if (AXIS_COUNT > 1) {
+        out.print((entry.kind >> EVENT_AXIS_SHIFT) + 1);
+        out.print(':');
+    }
+    if ((entry.kind & EVENT_KIND_MASK) == EVENT_ALARM) {
+        out.print(getAlarmTypeText((AlarmType)entry.detail));
+    } else if ((entry.kind & EVENT_KIND_MASK) == EVENT_RESET) {
+        out.print(F("RESET "));
+        out.print(getResetTypeText(entry.detail));
+    } else if ((entry.kind & EVENT_KIND_MASK) == EVENT_PLANT_DRIFT) {
+        out.print(F("DRIFT "));
+        if (entry.detail & PLANT_DRIFT_GAIN) {
+            out.print(F("K"));
+        }
+        if (entry.detail & PLANT_DRIFT_TAU) {
+            out.print(F("T"));
+        }
+    } else {
+        out.print(getStateText((SystemState)(entry.detail >> 4)));
+        out.print('>');
+        out.print(getStateText((SystemState)(entry.detail & 0x0F)));
+    }
+}
+
+// Dump the log as CSV, newest first
+void dumpEventLog(Print& out) {
+    EventLogEntry entry;
+
+    out.println(F("# index,uptime_s,event,current_A,speed_rpm"));
+    for (uint8_t i = 0; i < storedCount; i++) {
+        if (!readEventLogEntry(i, entry)) {
+            continue;
+        }
+        out.print(i);
+        out.print(',');
+        out.print(entry.uptime);
+        out.print(',');
+        printEventText(out, entry);
+        out.print(',');
+        printFixed(out, entry.current, 1);
+        out.print(',');
+        out.println(entry.speed);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Event log declarations for DC Motor Speed Control Project
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+#include "states.h"
+#include "alarms.h"
+#include "axis.h"
+
+// Event kinds
+enum EventKind {
+    EVENT_ALARM = 1,         // Alarm tripped, detail = AlarmType
+    EVENT_STATE_CHANGE = 2,  // State transition, detail = (from << 4) | to
+    EVENT_RESET = 3,         // Unexpected reset, detail = RSTCTRL.RSTFR flags
+    EVENT_PLANT_DRIFT = 4,   // Plant model left its baseline, detail = PlantDrift flags
+    EVENT_EMPTY = 0xFF       // Erased EEPROM slot
+};
+
+// Plant drift flags
+enum PlantDrift {
+    PLANT_DRIFT_GAIN = 0x01,
+    PLANT_DRIFT_TAU = 0x02
+};
+
+// The axis number is kept in the high nibble of the kind byte
+const uint8_t EVENT_KIND_MASK = 0x0F;
+const uint8_t EVENT_AXIS_SHIFT = 4;
+
+// Event log entry as stored in EEPROM (11 bytes, packed so that the host
+// tests use the same layout)
+struct __attribute__((packed)) EventLogEntry {
+    uint8_t kind;        // EventKind | axis << 4, written last to commit the entry
+    uint8_t sequence;    // Rolling write counter, used to find the ring head
+    uint8_t detail;      // Event specific detail
+    uint16_t current;    // Peak current at event in 0.1 A
+    uint16_t speed;      // Speed at event in RPM
+    uint32_t uptime;     // Seconds since power-up
+};
+
+// Ring buffer size
+const uint8_t EVENT_LOG_SIZE = 8;     // Entries stored in EEPROM
+const uint8_t EVENT_QUEUE_SIZE = 4;   // Entries waiting to be written
+
+// Function declarations
+void initializeEventLog();
+void logAlarm(MotorAxis& axis, AlarmType alarm);
+void logStateChange(MotorAxis& axis, SystemState from, SystemState to);
+void logReset(uint8_t cause);
+void logPlantDrift(MotorAxis& axis, uint8_t flags);
+void serviceEventLog();
+void clearEventLog();
+uint8_t getEventLogCount();
+bool readEventLogEntry(uint8_t index, EventLogEntry& entry);  // index 0 = newest
+void printEventText(Print& out, const EventLogEntry& entry);
+void dumpEventLog(Print& out);
+
+#endif
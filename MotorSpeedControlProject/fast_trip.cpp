@@ -0,0 +1,69 @@
+/*
+ * Hardware overcurrent trip implementation for DC Motor Speed Control Project
+ */
+
+#include "fast_trip.h"
+
+#if FAST_OVERCURRENT_TRIP
+
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "axis.h"
+#include "scaling.h"  // For inputScaling
+
+static volatile bool tripped = false;
+
+// PWM output of the watched axis, resolved once at startup
+static volatile uint8_t* pwmOutput;
+static uint8_t pwmMask;      // Pin in its port
+static uint8_t timerMask;    // Compare output enable in TCA0.SPLIT.CTRLB
+
+void initializeFastTrip() {
+    uint8_t pin = AXIS_PINS[FAST_TRIP_AXIS].pwm;
+
+    pwmOutput = portOutputRegister(digitalPinToPort(pin));
+    pwmMask = digitalPinToBitMask(pin);
+    timerMask = pwmMask;  // PBn is WOn, enabled by LCMPnEN = bit n
+
+    VREF.CTRLA = (VREF.CTRLA & ~VREF_AC0REFSEL_gm) | VREF_AC0REFSEL_4V34_gc;
+    VREF.CTRLB |= VREF_AC0REFEN_bm;
+
+    AC0.DACREF = inputScaling.overcurrentDacRef;
+    AC0.MUXCTRLA = FAST_TRIP_AC_MUXPOS | AC_MUXNEG_DACREF_gc;
+    AC0.STATUS = AC_CMP_bm;
+    AC0.INTCTRL = AC_CMP_bm;
+    AC0.CTRLA = AC_ENABLE_bm | AC_HYSMODE_50mV_gc | AC_INTMODE_POSEDGE_gc;
+}
+
+// Current crossed the threshold: PWM off first, then latch the trip
+ISR(AC0_AC_vect) {
+    TCA0.SPLIT.CTRLB &= ~timerMask;
+    *pwmOutput &= ~pwmMask;
+    AC0.STATUS = AC_CMP_bm;
+    tripped = true;
+}
+
+// Take a latched trip, called from readInputs(). Also follows threshold
+// changes, so the comparator needs no hook in the parameter code.
+bool takeFastTrip(const MotorAxis& axis) {
+    bool taken;
+
+    if (getAxisIndex(axis) != FAST_TRIP_AXIS) {
+        return false;
+    }
+    if (AC0.DACREF != inputScaling.overcurrentDacRef) {
+        AC0.DACREF = inputScaling.overcurrentDacRef;
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        taken = tripped;
+        tripped = false;
+    }
+    return taken;
+}
+
+bool isFastTripped(const MotorAxis& axis) {
+    return tripped && getAxisIndex(axis) == FAST_TRIP_AXIS;
+}
+
+#endif
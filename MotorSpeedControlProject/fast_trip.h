@@ -0,0 +1,48 @@
+/*
+ * Hardware overcurrent trip declarations for DC Motor Speed Control Project
+ *
+ * Built with FAST_OVERCURRENT_TRIP (config.h). The AC0 comparator compares
+ * the current sensor of the first axis against its DAC reference, set from
+ * the same threshold as the software overcurrent alarm. Its interrupt
+ * disconnects the TCA0 compare output and drives the PWM pin low within a
+ * few microseconds, whatever loop() is doing. The trip is latched: the next
+ * readInputs() of the axis raises the overcurrent alarm, and the PWM stays
+ * off until the ALARM state has been entered.
+ *
+ * The motor PWM pin of the axis must be a TCA0 WO0-WO2 output (D9 = PB0 = WO0).
+ * The DAC tops out at 255/256 of 4.34 V: a higher threshold (the default
+ * 90% of a 5 V sensor is 4.5 V) trips the hardware at 4.32 V, 86% of full
+ * scale, while the software alarm keeps its own threshold.
+ */
+
+#ifndef FAST_TRIP_H
+#define FAST_TRIP_H
+
+#include <stdint.h>
+#include "config.h"
+
+struct MotorAxis;  // See axis.h
+
+const uint16_t FAST_TRIP_VREF_MV = 4340;  // AC0 DAC reference (VREF 4.34 V)
+
+#if FAST_OVERCURRENT_TRIP
+
+#include <avr/io.h>  // For AC_MUXPOS_PIN1_gc
+
+const uint8_t FAST_TRIP_AXIS = 0;                          // Axis watched by AC0
+const uint8_t FAST_TRIP_AC_MUXPOS = AC_MUXPOS_PIN1_gc;     // AINP1 = PD4 = A6
+
+// Function declarations
+void initializeFastTrip();
+bool takeFastTrip(const MotorAxis& axis);      // True once after a trip
+bool isFastTripped(const MotorAxis& axis);     // Trip not yet taken
+
+#else
+
+inline void initializeFastTrip() {}
+inline bool takeFastTrip(const MotorAxis&) { return false; }
+inline bool isFastTripped(const MotorAxis&) { return false; }
+
+#endif
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Measurement filter implementation for DC Motor Speed Control Project
+ */
+
+#include "filters.h"
+#include <string.h>
+
+void initializeFilter(FilterChannel& filter, uint8_t chain) {
+    memset(&filter, 0, sizeof(filter));
+    filter.chain = chain;
+}
+
+// Fill every stage with the first sample, so the output starts without a
+// ramp from zero
+static void primeFilter(FilterChannel& filter, uint16_t sample) {
+    for (uint8_t i = 0; i < 3; i++) {
+        filter.median[i] = sample;
+    }
+    for (uint8_t i = 0; i < FILTER_AVERAGE_LENGTH; i++) {
+        filter.average[i] = sample;
+    }
+    filter.averageSum = sample << FILTER_AVERAGE_SHIFT;
+    filter.iir[0] = filter.iir[1] = (uint32_t)sample << FILTER_IIR_FRACTION;
+    filter.primed = true;
+}
+
+static uint16_t median3(uint16_t a, uint16_t b, uint16_t c) {
+    if (a > b) {
+        uint16_t t = a; a = b; b = t;
+    }
+    // a <= b: the median is b unless c is outside [a, b]
+    if (c < a) {
+        return a;
+    }
+    return c < b ? c : b;
+}
+
+// x * alpha / 2^16 in 32 bit math, for x < 2^24
+static uint32_t scaleQ16(uint32_t x, uint16_t alpha) {
+    return ((x >> 8) * alpha + (((x & 0xFF) * alpha) >> 8)) >> 8;
+}
+
+// One first-order stage in fixed point
+static uint32_t iirStage(uint32_t& state, uint32_t input, uint16_t alpha) {
+    if (input >= state) {
+        state += scaleQ16(input - state, alpha);
+    } else {
+        state -= scaleQ16(state - input, alpha);
+    }
+    return state;
+}
+
+// Coefficient for the sample interval, cached while the interval holds
+static uint16_t iirCoefficient(FilterChannel& filter, uint8_t shift, unsigned long dtMicros) {
+    if (dtMicros > FILTER_DT_MAX) {
+        dtMicros = FILTER_DT_MAX;
+    }
+    uint8_t dt = (dtMicros + (1 << (FILTER_DT_UNIT_SHIFT - 1))) >> FILTER_DT_UNIT_SHIFT;
+    if (dt == 0) {
+        dt = 1;
+    }
+
+    if (dt != filter.alphaDt || shift != filter.alphaShift) {
+        uint32_t dtUs = (uint32_t)dt << FILTER_DT_UNIT_SHIFT;
+        uint32_t tauUs = 1000UL << shift;
+        filter.alpha = dtUs * 65535 / (tauUs + dtUs);
+        filter.alphaDt = dt;
+        filter.alphaShift = shift;
+    }
+    return filter.alpha;
+}
+
+// Filter one sample of raw ADC counts
+uint16_t applyFilter(FilterChannel& filter, uint16_t sample, uint8_t iirShift,
+                     unsigned long dtMicros) {
+    if (!filter.primed) {
+        primeFilter(filter, sample);
+    }
+
+    if (filter.chain & FILTER_MEDIAN3) {
+        filter.median[filter.medianIndex] = sample;
+        filter.medianIndex = filter.medianIndex < 2 ? filter.medianIndex + 1 : 0;
+        sample = median3(filter.median[0], filter.median[1], filter.median[2]);
+    }
+
+    if (filter.chain & FILTER_AVERAGE) {
+        filter.averageSum += sample - filter.average[filter.averageIndex];
+        filter.average[filter.averageIndex] = sample;
+        filter.averageIndex = (filter.averageIndex + 1) % FILTER_AVERAGE_LENGTH;
+        sample = (filter.averageSum + FILTER_AVERAGE_LENGTH / 2) >> FILTER_AVERAGE_SHIFT;
+    }
+
+    if (iirShift == 0) {
+        // Keep the stages tracking, so enabling them later causes no step
+        filter.iir[0] = filter.iir[1] = (uint32_t)sample << FILTER_IIR_FRACTION;
+        return sample;
+    }
+    if (iirShift > FILTER_IIR_SHIFT_MAX) {
+        iirShift = FILTER_IIR_SHIFT_MAX;
+    }
+
+    uint16_t alpha = iirCoefficient(filter, iirShift, dtMicros);
+    uint32_t output = iirStage(filter.iir[0], (uint32_t)sample << FILTER_IIR_FRACTION, alpha);
+    if (filter.chain & FILTER_IIR2) {
+        output = iirStage(filter.iir[1], output, alpha);
+    }
+    return (output + (1 << (FILTER_IIR_FRACTION - 1))) >> FILTER_IIR_FRACTION;
+}
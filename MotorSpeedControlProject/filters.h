@@ -0,0 +1,63 @@
+/*
+ * Measurement filter declarations for DC Motor Speed Control Project
+ *
+ * Each input channel runs a short filter chain on raw ADC counts, once per
+ * sample and in integer math, so every sample costs the same:
+ *   median of 3      - removes single sample spikes
+ *   moving average   - running sum over FILTER_AVERAGE_LENGTH samples
+ *   IIR low-pass     - one or two cascaded first-order stages,
+ *                      y += (x - y) * dt / (tau + dt)
+ * The stages in a chain are fixed at compile time below. The IIR time
+ * constant is a parameter k, tau = 2^k ms (0 = stage bypassed). The
+ * coefficient follows the measured sample interval dt, so the corner
+ * frequency does not move when a display refresh lengthens a loop pass;
+ * it is only recomputed when dt changes by more than FILTER_DT_UNIT.
+ * The median and the average work on samples and are meant for spikes and
+ * sample noise, not for setting a bandwidth.
+ */
+
+#ifndef FILTERS_H
+#define FILTERS_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Filter stages
+enum FilterStage {
+    FILTER_MEDIAN3 = 0x01,   // Median of the last 3 samples
+    FILTER_AVERAGE = 0x02,   // Moving average
+    FILTER_IIR2 = 0x04       // Second IIR stage (critically damped second-order low-pass)
+};
+
+// Filter chain of each channel
+const uint8_t SPEED_FILTER_CHAIN = FILTER_MEDIAN3 | FILTER_AVERAGE;
+const uint8_t CURRENT_FILTER_CHAIN = FILTER_AVERAGE | FILTER_IIR2;
+
+const uint8_t FILTER_AVERAGE_SHIFT = 2;                          // log2 of the length
+const uint8_t FILTER_AVERAGE_LENGTH = 1 << FILTER_AVERAGE_SHIFT;
+const uint8_t FILTER_IIR_SHIFT_MAX = 6;                          // Up to 64 ms
+const uint8_t FILTER_IIR_FRACTION = 8;                           // Fractional bits of the IIR state
+const uint8_t FILTER_DT_UNIT_SHIFT = 6;                          // Sample interval unit, 64 us
+const unsigned long FILTER_DT_MAX = 255UL << FILTER_DT_UNIT_SHIFT;  // Longer intervals count as this
+
+// Filter state of one channel
+struct FilterChannel {
+    uint8_t chain;                              // FilterStage flags
+    bool primed;                                // State holds a sample
+    uint16_t median[3];
+    uint8_t medianIndex;
+    uint16_t average[FILTER_AVERAGE_LENGTH];
+    uint16_t averageSum;
+    uint8_t averageIndex;
+    uint32_t iir[2];                            // IIR stage outputs, Q8
+    uint16_t alpha;                             // IIR coefficient dt / (tau + dt), Q16
+    uint8_t alphaDt;                            // Sample interval of alpha, FILTER_DT_UNIT
+    uint8_t alphaShift;                         // Time constant of alpha
+};
+
+// Function declarations
+void initializeFilter(FilterChannel& filter, uint8_t chain);
+uint16_t applyFilter(FilterChannel& filter, uint16_t sample, uint8_t iirShift,
+                     unsigned long dtMicros);  // dt = time since the previous sample
+
+#endif
@@ -5,30 +5,20 @@
 #ifndef GLOBALS_H
 #define GLOBALS_H
 
-#include <PID_v1.h>
 #include <U8g2lib.h>
 #include "config.h"
 #include "states.h"
 #include "menu.h"  // Per MenuState e MenuItem
+#include "axis.h"  // For axes[] and activeAxis()
 
 // System parameters instance
 extern SystemParameters systemParams;
 
-// PID variables
-extern double pidInput, pidOutput, pidSetpoint;
-extern PID motorPID;
-
 // Display instance
 extern U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2;
 
 // State variables
-extern SystemState currentState;
 extern MenuState currentMenu;
 extern MenuItem selectedItem;
 
-// Global flags
-extern bool isOvercurrent;
-extern float currentSpeed;
-extern float currentCurrent;
-
 #endif 
\ No newline at end of file
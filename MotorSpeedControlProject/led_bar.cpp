@@ -0,0 +1,150 @@
+/*
+ * LED bar implementation for DC Motor Speed Control Project
+ */
+
+#include "led_bar.h"
+#include <Arduino.h>
+#include <util/atomic.h>
+#include "pins.h"
+#include "globals.h"
+#include "scaling.h"
+
+// Port of every LED, and the bar bits of every port used
+static uint8_t ledPortIndex[LED_BAR_COUNT];
+static uint8_t ledMask[LED_BAR_COUNT];
+static VPORT_t* ledPorts[LED_BAR_MAX_PORTS];
+static uint8_t ledPortMask[LED_BAR_MAX_PORTS];
+static uint8_t ledPortCount = 0;
+
+// Dithered LED, owned by the tick interrupt
+static VPORT_t* volatile ditherPort = NULL;
+static volatile uint8_t ditherMask = 0;
+static volatile uint8_t ditherLevel = 0;   // On ticks per LED_BAR_DITHER_STEPS
+
+// Resolve the port registers of the bar, grouped by port
+void initializeLedBar() {
+    ledPortCount = 0;
+    for (uint8_t i = 0; i < LED_BAR_COUNT; i++) {
+        VPORT_t* port = &VPORTA + digitalPinToPort(LED_BAR_PINS[i]);
+        uint8_t index = 0;
+
+        while (index < ledPortCount && ledPorts[index] != port) {
+            index++;
+        }
+        if (index == ledPortCount && ledPortCount < LED_BAR_MAX_PORTS) {
+            ledPorts[ledPortCount] = port;
+            ledPortMask[ledPortCount] = 0;
+            ledPortCount++;
+        }
+        ledPortIndex[i] = index;
+        ledMask[i] = digitalPinToBitMask(LED_BAR_PINS[i]);
+        ledPortMask[index] |= ledMask[i];
+    }
+}
+
+// Sigma-delta step of the dithered LED, one per tick
+void serviceLedDither() {
+    static uint8_t accumulator = 0;
+
+    if (ditherMask == 0) {
+        return;
+    }
+    accumulator += ditherLevel;
+    if (accumulator >= LED_BAR_DITHER_STEPS) {
+        accumulator -= LED_BAR_DITHER_STEPS;
+        ditherPort->OUT |= ditherMask;
+    } else {
+        ditherPort->OUT &= ~ditherMask;
+    }
+}
+
+// Light the LEDs set in lit, and dither LED dither (or none if out of range)
+static void writeLedBar(uint8_t lit, uint8_t dither, uint8_t level) {
+    uint8_t bits[LED_BAR_MAX_PORTS] = {0};
+
+    for (uint8_t i = 0; i < LED_BAR_COUNT; i++) {
+        if (lit & (1 << i)) {
+            bits[ledPortIndex[i]] |= ledMask[i];
+        }
+    }
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        // Hand the partial LED to the tick interrupt first, so it never
+        // drives an LED written below
+        if (dither < LED_BAR_COUNT && level > 0) {
+            ditherPort = ledPorts[ledPortIndex[dither]];
+            ditherMask = ledMask[dither];
+            ditherLevel = level;
+        } else {
+            ditherMask = 0;
+        }
+
+        for (uint8_t i = 0; i < ledPortCount; i++) {
+            uint8_t mask = ledPortMask[i];
+            if (ledPorts[i] == ditherPort) {
+                mask &= ~ditherMask;
+            }
+            ledPorts[i]->OUT = (ledPorts[i]->OUT & ~mask) | bits[i];
+        }
+    }
+}
+
+// Fill count 1/16 LEDs from LED first, stepping by direction
+static void fillLedBar(uint8_t& lit, uint8_t& dither, uint8_t& level,
+                       uint8_t first, int8_t direction, uint16_t count) {
+    uint8_t led = first;
+
+    while (count >= LED_BAR_DITHER_STEPS && led < LED_BAR_COUNT) {
+        lit |= 1 << led;
+        led += direction;
+        count -= LED_BAR_DITHER_STEPS;
+    }
+    dither = led;  // Out of range (wraps past 0) when the bar is full
+    level = count < LED_BAR_DITHER_STEPS ? count : 0;
+}
+
+// Show the selected quantity of the active axis
+void updateLedBar() {
+    static unsigned long lastUpdate = 0;
+    const uint8_t shift = SCALING_SHIFT - LED_BAR_DITHER_BITS;
+    unsigned long currentMillis = millis();
+    
+    // Update LED bar only at specified intervals
+    if (currentMillis - lastUpdate < LED_BAR_UPDATE_INTERVAL) {
+        return;
+    }
+    lastUpdate = currentMillis;
+
+    const MotorAxis& axis = activeAxis();
+    uint8_t lit = 0;
+    uint8_t dither = LED_BAR_COUNT;
+    uint8_t level = 0;
+
+    switch (systemParams.ledBarMode) {
+        case LED_BAR_CURRENT:
+            fillLedBar(lit, dither, level, 0, 1,
+                       (axis.milliAmps * inputScaling.ledsPerMilliAmp) >> shift);
+            break;
+
+        case LED_BAR_ERROR: {
+            // Centre LED marks zero, speed above the setpoint fills to the right
+            const uint8_t centre = LED_BAR_COUNT / 2;
+            int32_t error = (int32_t)axis.speed - (int32_t)axis.pidSetpoint;
+            uint16_t count = (labs(error) * inputScaling.ledsPerErrorRpm) >> shift;
+
+            lit = 1 << centre;
+            if (isMotorRunning(axis) && error != 0) {
+                fillLedBar(lit, dither, level, error > 0 ? centre + 1 : centre - 1,
+                           error > 0 ? 1 : -1, count);
+            }
+            break;
+        }
+
+        default:
+            fillLedBar(lit, dither, level, 0, 1,
+                       (axis.speed * inputScaling.ledsPerRpm) >> shift);
+            break;
+    }
+
+    writeLedBar(lit, dither, level);
+}
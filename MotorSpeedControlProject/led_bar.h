@@ -0,0 +1,37 @@
+/*
+ * LED bar declarations for DC Motor Speed Control Project
+ *
+ * The bar LEDs sit on three ports (PA, PC, PE on the Nano Every). Their
+ * virtual port registers and masks are resolved once at startup and grouped
+ * by port, so a refresh is one read-modify-write of VPORTx.OUT per port
+ * instead of a digitalWrite() per LED.
+ *
+ * The bar level is kept in 1/16 of an LED. The last, partly lit LED is
+ * dithered from the tick interrupt: a first-order sigma-delta turns it on
+ * for level/16 of the ticks, spread as evenly as possible.
+ */
+
+#ifndef LED_BAR_H
+#define LED_BAR_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Quantities shown on the bar
+enum LedBarMode {
+    LED_BAR_SPEED,     // Speed, 0 to full scale
+    LED_BAR_CURRENT,   // Current, 0 to full scale
+    LED_BAR_ERROR      // Speed - setpoint, centre LED = 0
+};
+
+const uint8_t LED_BAR_DITHER_BITS = 4;            // Level resolution is 1/16 LED
+const uint8_t LED_BAR_DITHER_STEPS = 1 << LED_BAR_DITHER_BITS;
+const uint8_t LED_BAR_ERROR_RANGE_PERCENT = 10;   // Error of a half bar, % of speed full scale
+const uint8_t LED_BAR_MAX_PORTS = 3;
+
+// Function declarations
+void initializeLedBar();
+void updateLedBar();
+void serviceLedDither();  // Called from the tick interrupt
+
+#endif
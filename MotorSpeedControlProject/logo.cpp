@@ -5,15 +5,16 @@
 #include "logo.h"
 #include <string.h>
 #include "globals.h"
+#include "display.h"  // For drawText()
 
 
 
 void Logo(void) {
   u8g2.setFontDirection(0);
   u8g2.setFont(u8g2_font_inb24_mf);
-  u8g2.drawStr(5, 0, "IIS");
-  u8g2.drawStr(5, 30, "Lonigo");
+  drawText(5, 0, F("IIS"));
+  drawText(5, 30, F("Lonigo"));
 
   u8g2.setFont(u8g2_font_4x6_tr);
-  u8g2.drawStr(5,57,"DC Motor Control V1.0");
+  drawText(5, 57, F("DC Motor Control V1.0"));
 }
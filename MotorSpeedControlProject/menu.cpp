@@ -8,8 +8,13 @@
 #include "display.h"
 #include "eeprom_manager.h"  // For saveParameters()
 #include "pid.h"            // For updatePIDParameters()
-#include "states.h"         // For SystemState and currentState
-#include <debounce.h>
+#include "states.h"         // For SystemState
+#include "axis.h"           // For activeAxis()
+#include "event_log.h"      // For getEventLogCount()
+#include "utils.h"          // For printFixed()
+#include "buttons.h"        // For takeButtonPresses()
+#include "scaling.h"        // For updateScaling()
+#include "program.h"        // For startProgram()
 
 // Menu global variables definition
 MenuState currentMenu = MENU_NONE;
@@ -18,119 +23,372 @@ unsigned long lastMenuActivity = 0;
 bool editingValue = false;
 unsigned long lastButtonPress = 0;
 bool hasUnsavedChanges = false;
+uint8_t eventLogView = 0;
 unsigned long currentMillis;
 extern bool popupActive;
 extern bool popupNeedsConfirmation;
 
+// Confirmation pending on the reset popup
+static bool resetRequested = false;
+
+// Value of the edited parameter when the edit began
+static float editStartValue = 0;
+
+// Parameter table
+#define MENU_PARAM_UNIT(id, var, type, format, minValue, maxValue, step, unit) \
+    static const char UNIT_##id[] PROGMEM = unit;
+MENU_PARAM_LIST(MENU_PARAM_UNIT)
+
+#define MENU_PARAM_ROW(id, var, type, format, minValue, maxValue, step, unit) \
+    { (void*)&var, type, format, minValue, maxValue, step, UNIT_##id },
+static const MenuParam MENU_PARAMS[MENU_PARAM_COUNT] PROGMEM = {
+    MENU_PARAM_LIST(MENU_PARAM_ROW)
+};
+
+// Entry table
+#define MENU_ENTRY_LABEL(id, page, label, action, arg, visibility) \
+    static const char LABEL_##id[] PROGMEM = label;
+MENU_ENTRY_LIST(MENU_ENTRY_LABEL)
+
+#define MENU_ENTRY_ROW(id, page, label, action, arg, visibility) \
+    { LABEL_##id, page, action, arg, visibility },
+static const MenuEntry MENU_ENTRIES[MENU_ITEM_COUNT] PROGMEM = {
+    MENU_ENTRY_LIST(MENU_ENTRY_ROW)
+};
+
+// Parent of each page, indexed by MenuState
+static const uint8_t MENU_PARENT[] PROGMEM = {
+    MENU_NONE,      // MENU_MAIN
+    MENU_MAIN,      // MENU_SETTINGS
+    MENU_SETTINGS,  // MENU_PID
+    MENU_SETTINGS,  // MENU_CALIBRATION
+    MENU_SETTINGS,  // MENU_EVENT_LOG
+    MENU_SETTINGS,  // MENU_COUNTERS
+    MENU_SETTINGS,  // MENU_SYNC
+    MENU_SETTINGS   // MENU_DIAGNOSTICS
+};
+static_assert(sizeof(MENU_PARENT) == MENU_NONE, "MENU_PARENT must list every page");
+
+void getMenuEntry(MenuItem item, MenuEntry& entry) {
+    memcpy_P(&entry, &MENU_ENTRIES[item], sizeof(MenuEntry));
+}
+
+void getMenuParam(uint8_t id, MenuParam& param) {
+    memcpy_P(&param, &MENU_PARAMS[id], sizeof(MenuParam));
+}
+
+static bool isEntryVisible(const MenuEntry& entry) {
+    switch(entry.visibility) {
+        case SHOW_STOPPED:
+            return !isMotorRunning(activeAxis());
+        case SHOW_RUNNING:
+            return isMotorRunning(activeAxis());
+        case SHOW_MULTI_AXIS:
+            return AXIS_COUNT > 1;
+        default:
+            return true;
+    }
+}
+
+// Collect the visible items of a page in display order
+uint8_t getMenuPageItems(MenuState page, MenuItem* items) {
+    MenuEntry entry;
+    uint8_t count = 0;
+
+    for (uint8_t i = 0; i < MENU_ITEM_COUNT && count < MENU_MAX_PAGE_ITEMS; i++) {
+        getMenuEntry((MenuItem)i, entry);
+        if (entry.page == page && isEntryVisible(entry)) {
+            items[count++] = (MenuItem)i;
+        }
+    }
+    return count;
+}
+
+// Open a page, selecting the entry that leads to 'from' if there is one
+static void openPage(MenuState page, MenuState from) {
+    MenuItem items[MENU_MAX_PAGE_ITEMS];
+    MenuEntry entry;
+    uint8_t count = getMenuPageItems(page, items);
+
+    currentMenu = page;
+    editingValue = false;
+    if (count == 0) {
+        return;
+    }
+
+    selectedItem = items[0];
+    for (uint8_t i = 0; i < count; i++) {
+        getMenuEntry(items[i], entry);
+        if (entry.action == ACTION_PAGE && entry.arg == from) {
+            selectedItem = items[i];
+        }
+    }
+}
+
+static MenuState getParentPage(MenuState page) {
+    if (page >= MENU_NONE) {
+        return MENU_NONE;
+    }
+    return (MenuState)pgm_read_byte(&MENU_PARENT[page]);
+}
+
+static float readParamValue(const MenuParam& param) {
+    switch(param.type) {
+        case PARAM_FLOAT:
+            return *(float*)param.value;
+        case PARAM_INT:
+            return *(int*)param.value;
+        default:
+            return *(uint8_t*)param.value;
+    }
+}
+
+static void writeParamValue(const MenuParam& param, float value) {
+    switch(param.type) {
+        case PARAM_FLOAT:
+            *(float*)param.value = value;
+            break;
+        case PARAM_INT:
+            *(int*)param.value = (int)(value + (value < 0 ? -0.5f : 0.5f));
+            break;
+        default:
+            *(uint8_t*)param.value = (uint8_t)(value + 0.5f);
+            break;
+    }
+    updateScaling();  // Full scales apply immediately
+}
+
+// Every parameter lives in systemParams and is saved to EEPROM, except the
+// axis selection, which only applies to the running session
+static bool isParamStored(uint8_t id) {
+    return id != PARAM_AXIS;
+}
+
+// Start editing the parameter of the selected entry
+static void beginEdit(const MenuEntry& entry) {
+    MenuParam param;
+
+    getMenuParam(entry.arg, param);
+    editStartValue = readParamValue(param);
+    editingValue = true;
+}
+
+// Keep the edited value, saving it if the parameter is stored
+static void commitEdit() {
+    MenuEntry entry;
+
+    getMenuEntry(selectedItem, entry);
+    if (isParamStored(entry.arg)) {
+        ::saveParameters();
+    }
+    updatePIDParameters();
+    editingValue = false;
+    hasUnsavedChanges = false;
+}
+
+// Drop the edit in progress: stored parameters are reloaded from EEPROM,
+// others get back their value from the start of the edit
+static void revertEdit() {
+    MenuEntry entry;
+    MenuParam param;
+
+    getMenuEntry(selectedItem, entry);
+    if (isParamStored(entry.arg)) {
+        loadParameters();
+    } else {
+        getMenuParam(entry.arg, param);
+        writeParamValue(param, editStartValue);
+    }
+    editingValue = false;
+    hasUnsavedChanges = false;
+}
+
+// Print a parameter value with its unit, e.g. "30.0A" or "Ramp"
+void printParamValue(Print& out, uint8_t id) {
+    MenuParam param;
+
+    getMenuParam(id, param);
+    float value = readParamValue(param);
+
+    if (param.format == FORMAT_CHOICE) {
+        // Print the n-th option of the '|' separated list
+        uint8_t index = (uint8_t)(value - param.minValue);
+        const char* option = param.unit;
+        char c;
+        while (index > 0 && (c = pgm_read_byte(option)) != '\0') {
+            option++;
+            if (c == '|') {
+                index--;
+            }
+        }
+        while ((c = pgm_read_byte(option++)) != '\0' && c != '|') {
+            out.write(c);
+        }
+        return;
+    }
+
+    switch(param.format) {
+        case FORMAT_DEC1:
+            printFixed(out, toFixed(value, 1), 1);
+            break;
+        case FORMAT_DEC2:
+            printFixed(out, toFixed(value, 2), 2);
+            break;
+        default:
+            printFixed(out, toFixed(value, 0));
+            break;
+    }
+    out.print(FPSTR(param.unit));
+}
+
+
 // Add popup response handling
 void handlePopupResponse(bool confirmed) {
-    static MenuState previousMenu = MENU_NONE;
-    
     if (confirmed) {
         if (editingValue) {
-            ::saveParameters();
-            if (currentMenu == MENU_PID) {
-                updatePIDParameters();
-            }
-            editingValue = false;
-            hasUnsavedChanges = false;
-        }
-        
-        // Handle calibration confirmation
-        if (currentMenu == MENU_CALIBRATION) {
+            commitEdit();
+        } else if (resetRequested) {
+            resetToDefaults();
+        } else if (currentMenu == MENU_CALIBRATION) {
+            // Handle calibration confirmation
             handleCalibration();
         }
     } else {
         // If not confirmed, revert to previous state
         if (editingValue) {
-            loadParameters();  // Reload from EEPROM
-            editingValue = false;
-            hasUnsavedChanges = false;
+            revertEdit();
+        }
+        if (currentMenu == MENU_CALIBRATION) {
+            openPage(MENU_SETTINGS, MENU_CALIBRATION);
         }
-        currentMenu = previousMenu;
     }
+    resetRequested = false;
 }
 
-static void buttonUpHandler(uint8_t btnId, uint8_t btnState) {
-    if (btnState == BTN_PRESSED) {
-        lastMenuActivity = currentMillis;
-        if (currentMenu == MENU_NONE && currentState == STATE_RUN) {
-            // Se siamo nella schermata principale e in running, modifica setpoint
-            adjustSetpoint(true);
-        }
-        else if (editingValue) {
-            adjustValue(true);
-        } else {
-            navigateMenu(true);
+// UP/DOWN: local setpoint on the main screen while running, value while
+// editing, selection otherwise. The multiplier scales the step during
+// auto-repeat.
+static void handleUpDown(bool up, uint8_t multiplier) {
+    lastMenuActivity = currentMillis;
+    if (currentMenu == MENU_NONE && isMotorRunning(activeAxis())) {
+        // Se siamo nella schermata principale e in running, modifica setpoint
+        if (getSetpointSource(activeAxis()) == SOURCE_LOCAL) {
+            adjustSetpoint(activeAxis(), up, multiplier);
         }
+    }
+    else if (editingValue) {
+        adjustValue(up, multiplier);
     } else {
-        // btnState == BTN_OPEN.
+        navigateMenu(up);
     }
 }
 
-static void buttonDownHandler(uint8_t btnId, uint8_t btnState) {
-    if (btnState == BTN_PRESSED) {
-        lastMenuActivity = currentMillis;
-        if (currentMenu == MENU_NONE && currentState == STATE_RUN) {
-            // Se siamo nella schermata principale e in running, modifica setpoint
-            adjustSetpoint(false);
+static void buttonEnterHandler() {
+    lastMenuActivity = currentMillis;
+
+    // Controlla se il popup è attivo
+    if (popupActive) {
+        // Gestisci la risposta al popup
+        if (popupNeedsConfirmation) {
+            handlePopupResponse(true);  // Conferma
+            popupActive = false;         // Nascondi il popup
         }
-        else if (editingValue) {
-            adjustValue(false);
-        } else {
-            navigateMenu(false);
+    }
+    else {
+        handleMenuSelection();
+    }
+}
+
+static void buttonBackHandler() {
+    lastMenuActivity = currentMillis;
+
+    // Controlla se il popup è attivo
+    if (popupActive) {
+        // Gestisci la risposta al popup
+        if (popupNeedsConfirmation) {
+            handlePopupResponse(false);  // Annulla
+            popupActive = false;          // Nascondi il popup
         }
+    }
+    else
+        handleBackButton();
+}
+
+// UP+DOWN chord: drop the edit in progress, stop the motor from the main
+// screen, or leave the menu
+static void handleChord() {
+    lastMenuActivity = currentMillis;
+    wakeDisplay();
+    if (popupActive) {
+        return;
+    }
+
+    if (editingValue) {
+        revertEdit();
+    } else if (currentMenu == MENU_NONE) {
+        stopMotor(activeAxis());
     } else {
-        // btnState == BTN_OPEN.
+        currentMenu = MENU_NONE;
     }
 }
 
-static void buttonEnterHandler(uint8_t btnId, uint8_t btnState) {
-    if (btnState == BTN_PRESSED) {
-        lastMenuActivity = currentMillis;
+// Dispatch debounced button events: presses, chord and UP/DOWN auto-repeat
+static void processButtons() {
+    const uint8_t UP_DOWN = (1 << BUTTON_UP) | (1 << BUTTON_DOWN);
+    static unsigned long repeatStart = 0;
+    static unsigned long lastRepeat = 0;
+    static uint8_t repeatCount = 0;
+    static bool chordActive = false;
 
-        // Controlla se il popup è attivo
-        if (popupActive) {
-            // Gestisci la risposta al popup
-            if (popupNeedsConfirmation) {
-                    handlePopupResponse(true);  // Conferma
-                    popupActive = false;         // Nascondi il popup
-                }
+    uint8_t presses = takeButtonPresses();
+    uint8_t held = getButtonState();
+
+    // Chord fires once, then waits until both buttons are released
+    if ((held & UP_DOWN) == UP_DOWN) {
+        if (!chordActive) {
+            chordActive = true;
+            handleChord();
         }
-        else {
-            handleMenuSelection();
+        return;
+    }
+    if (chordActive) {
+        if ((held & UP_DOWN) == 0) {
+            chordActive = false;
         }
-    } else {
-        // btnState == BTN_OPEN.
+        return;
+    }
 
+    // The first press on a dimmed or blank display only wakes it up
+    if (presses && wakeDisplay()) {
+        repeatStart = currentMillis;
+        return;
     }
-}
 
-static void buttonBackHandler(uint8_t btnId, uint8_t btnState) {
-    if (btnState == BTN_PRESSED) {
-        lastMenuActivity = currentMillis;
+    if (presses & (1 << BUTTON_ENTER)) {
+        buttonEnterHandler();
+    }
+    if (presses & (1 << BUTTON_BACK)) {
+        buttonBackHandler();
+    }
 
-        // Controlla se il popup è attivo
-        if (popupActive) {
-            // Gestisci la risposta al popup
-            if (popupNeedsConfirmation) {
-                handlePopupResponse(false);  // Annulla
-                popupActive = false;          // Nascondi il popup
-                }
+    if (presses & UP_DOWN) {
+        handleUpDown(presses & (1 << BUTTON_UP), 1);
+        repeatStart = currentMillis;
+        lastRepeat = currentMillis;
+        repeatCount = 0;
+    } else if ((held & UP_DOWN) &&
+               currentMillis - repeatStart >= REPEAT_DELAY &&
+               currentMillis - lastRepeat >= REPEAT_INTERVAL) {
+        // Long press: the step doubles every REPEAT_ACCEL_COUNT repeats
+        uint8_t shift = min(repeatCount / REPEAT_ACCEL_COUNT, REPEAT_MAX_SHIFT);
+        handleUpDown(held & (1 << BUTTON_UP), 1 << shift);
+        lastRepeat = currentMillis;
+        if (repeatCount < 255) {
+            repeatCount++;
         }
-        else
-            handleBackButton();
-    } else {
-        // btnState == BTN_OPEN.
     }
 }
 
-// Initialize debounce objects
-static Button buttonUp(0, buttonUpHandler);
-static Button buttonDown(0, buttonDownHandler);
-static Button buttonEnter(0, buttonEnterHandler);
-static Button buttonBack(0, buttonBackHandler);
-
 // Process menu navigation
 void processMenu() {
     static unsigned long lastSaveCheck = 0;
@@ -146,7 +404,7 @@ void processMenu() {
             updatePIDParameters();
         }
         hasUnsavedChanges = false;
-        showMessage("Auto-saved");
+        showMessage(F("Auto-saved"));
         lastSaveCheck = currentMillis;
     }
     
@@ -158,93 +416,75 @@ void processMenu() {
         return;
     }
     
-    // Update buttons state
-    buttonUp.update(digitalRead(BUTTON_UP_PIN));
-    buttonDown.update(digitalRead(BUTTON_DOWN_PIN));
-    buttonEnter.update(digitalRead(BUTTON_ENTER_PIN));
-    buttonBack.update(digitalRead(BUTTON_BACK_PIN));
-    
+    // Handle button events sampled by the tick interrupt
+    processButtons();
 
 }
 
 // Handle menu selection
 void handleMenuSelection() {
-    switch(currentMenu) {
-        case MENU_NONE:
-            currentMenu = MENU_MAIN;
-            selectedItem = (currentState == STATE_RUN) ? ITEM_STOP : ITEM_RUN;
-            break;
-            
-        case MENU_MAIN:
-            switch(selectedItem) {
-                case ITEM_RUN:
-                    if (currentState != STATE_ALARM) {
-                        currentState = STATE_RUN;
-                        currentMenu = MENU_NONE;
-                    }
-                    break;
-                case ITEM_STOP:
-                    currentState = STATE_IDLE;
-                    pidSetpoint = 0;  // Reset setpoint
-                    currentMenu = MENU_NONE;
-                    break;
-                case ITEM_SETTINGS:
-                    currentMenu = MENU_SETTINGS;
-                    selectedItem = ITEM_CURRENT_FS;
-                    break;
-                case ITEM_BACK:
-                    currentMenu = MENU_NONE;
-                    break;
+    MenuEntry entry;
+
+    if (currentMenu == MENU_NONE) {
+        openPage(MENU_MAIN, MENU_NONE);
+        return;
+    }
+
+    // Pages without entries (event log, counters, diagnostics, calibration)
+    getMenuEntry(selectedItem, entry);
+    if (entry.page != currentMenu) {
+        return;
+    }
+
+    switch(entry.action) {
+        case ACTION_PAGE:
+            openPage((MenuState)entry.arg, currentMenu);
+            if (currentMenu == MENU_EVENT_LOG) {
+                eventLogView = 0;
             }
             break;
-            
-        case MENU_SETTINGS:
-            switch(selectedItem) {
-                case ITEM_CURRENT_FS:
-                case ITEM_SPEED_FS:
-                    editingValue = !editingValue;
-                    if (!editingValue) {
-                        ::saveParameters();
-                    }
-                    break;
-                case ITEM_PID_P:
-                    currentMenu = MENU_PID;
-                    selectedItem = ITEM_PID_P;
-                    break;
-                case ITEM_RESET:
-                    showPopup("Warning", "Reset to defaults?", true);
-                    break;
-                case ITEM_CALIBRATION:
-                    currentMenu = MENU_CALIBRATION;
-                    handleCalibration();
-                    break;
-                case ITEM_BACK:
-                    currentMenu = MENU_MAIN;
-                    selectedItem = ITEM_RUN;
-                    break;
+
+        case ACTION_BACK:
+            handleBackButton();
+            break;
+
+        case ACTION_EDIT:
+            if (editingValue) {
+                commitEdit();
+            } else {
+                beginEdit(entry);
             }
             break;
-            
-        case MENU_PID:
-            switch(selectedItem) {
-                case ITEM_PID_P:
-                case ITEM_PID_I:
-                case ITEM_PID_D:
-                    editingValue = !editingValue;
-                    if (!editingValue) {
-                        ::saveParameters();
-                        updatePIDParameters();
-                    }
-                    break;
-                case ITEM_BACK:
-                    currentMenu = MENU_SETTINGS;
-                    selectedItem = ITEM_PID_P;
-                    break;
+
+        case ACTION_START:
+            if (activeAxis().state != STATE_ALARM) {
+                startMotor(activeAxis());
+                currentMenu = MENU_NONE;
             }
             break;
-            
-        case MENU_CALIBRATION:
-            // Handled by handleCalibration()
+
+        case ACTION_STOP:
+            stopMotor(activeAxis());
+            activeAxis().localSetpoint = 0;  // Reset setpoint
+            currentMenu = MENU_NONE;
+            break;
+
+        case ACTION_RESET:
+            resetRequested = true;
+            showPopup(F("Warning"), F("Reset to defaults?"), true);
+            break;
+
+        case ACTION_CALIBRATION:
+            currentMenu = MENU_CALIBRATION;
+            handleCalibration();
+            break;
+
+        case ACTION_PROGRAM:
+            if (startProgram()) {
+                currentMenu = MENU_NONE;
+            } else {
+                showMessage(F("No program"));
+            }
             break;
     }
 }
@@ -259,51 +499,37 @@ void initializeMenu() {
 
 // Navigate menu up or down
 void navigateMenu(bool up) {
+    MenuItem items[MENU_MAX_PAGE_ITEMS];
+    uint8_t count;
+
     switch(currentMenu) {
-        case MENU_MAIN:
+        case MENU_EVENT_LOG:
+            // Scroll through the log, newest entry first
             if (up) {
-                if (selectedItem == ITEM_RUN || selectedItem == ITEM_STOP) 
-                    selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_SETTINGS) 
-                    selectedItem = (currentState == STATE_RUN) ? ITEM_STOP : ITEM_RUN;
-                else if (selectedItem == ITEM_BACK) 
-                    selectedItem = ITEM_SETTINGS;
+                if (eventLogView > 0) eventLogView--;
             } else {
-                if (selectedItem == ITEM_RUN || selectedItem == ITEM_STOP) 
-                    selectedItem = ITEM_SETTINGS;
-                else if (selectedItem == ITEM_SETTINGS) 
-                    selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_BACK) 
-                    selectedItem = (currentState == STATE_RUN) ? ITEM_STOP : ITEM_RUN;
+                if (eventLogView + 1 < getEventLogCount()) eventLogView++;
             }
             break;
-            
-        case MENU_SETTINGS:
-            if (up) {
-                if (selectedItem == ITEM_CURRENT_FS) selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_SPEED_FS) selectedItem = ITEM_CURRENT_FS;
-                else if (selectedItem == ITEM_PID_P) selectedItem = ITEM_SPEED_FS;
-                else if (selectedItem == ITEM_BACK) selectedItem = ITEM_PID_P;
-            } else {
-                if (selectedItem == ITEM_CURRENT_FS) selectedItem = ITEM_SPEED_FS;
-                else if (selectedItem == ITEM_SPEED_FS) selectedItem = ITEM_PID_P;
-                else if (selectedItem == ITEM_PID_P) selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_BACK) selectedItem = ITEM_CURRENT_FS;
+
+        default:
+            // Move to the previous/next visible entry, wrapping around
+            count = getMenuPageItems(currentMenu, items);
+            if (count == 0) {
+                break;
+            }
+            uint8_t position = 0;
+            for (uint8_t i = 0; i < count; i++) {
+                if (items[i] == selectedItem) {
+                    position = i;
+                }
             }
-            break;
-            
-        case MENU_PID:
             if (up) {
-                if (selectedItem == ITEM_PID_P) selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_PID_I) selectedItem = ITEM_PID_P;
-                else if (selectedItem == ITEM_PID_D) selectedItem = ITEM_PID_I;
-                else if (selectedItem == ITEM_BACK) selectedItem = ITEM_PID_D;
+                position = (position == 0) ? count - 1 : position - 1;
             } else {
-                if (selectedItem == ITEM_PID_P) selectedItem = ITEM_PID_I;
-                else if (selectedItem == ITEM_PID_I) selectedItem = ITEM_PID_D;
-                else if (selectedItem == ITEM_PID_D) selectedItem = ITEM_BACK;
-                else if (selectedItem == ITEM_BACK) selectedItem = ITEM_PID_P;
+                position = (position + 1 == count) ? 0 : position + 1;
             }
+            selectedItem = items[position];
             break;
     }
 }
@@ -312,94 +538,51 @@ void navigateMenu(bool up) {
 void handleBackButton() {
     if (editingValue) {
         if (hasUnsavedChanges) {
-            showPopup("Warning", "Save changes?", true);
+            showPopup(F("Warning"), F("Save changes?"), true);
             return;
         }
         editingValue = false;
         return;
     }
-    
-    switch(currentMenu) {
-        case MENU_MAIN:
-            currentMenu = MENU_NONE;
-            break;
-        case MENU_SETTINGS:
-        case MENU_PID:
-            if (hasUnsavedChanges) {
-                showPopup("Warning", "Discard changes?", true);
-                return;
-            }
-            currentMenu = MENU_MAIN;
-            selectedItem = ITEM_RUN;
-            break;
-        default:
-            break;
+
+    if (currentMenu == MENU_NONE) {
+        toggleTrendView();
+        return;
     }
+    openPage(getParentPage(currentMenu), currentMenu);
 }
 
-// Adjust value being edited
-void adjustValue(bool increase) {
-    const float STEP_SMALL = 0.1f;
-    const float STEP_LARGE = 1.0f;
-    const int STEP_SPEED = 100;
-    bool limitReached = false;
-    
-    switch(selectedItem) {
-        case ITEM_CURRENT_FS:
-            if (increase) {
-                if (systemParams.currentFullScale >= 50.0f) {
-                    limitReached = true;
-                } else {
-                    systemParams.currentFullScale += STEP_LARGE;
-                }
-            } else {
-                if (systemParams.currentFullScale <= 1.0f) {
-                    limitReached = true;
-                } else {
-                    systemParams.currentFullScale = max(1.0f, systemParams.currentFullScale - STEP_LARGE);
-                }
-            }
-            break;
-            
-        case ITEM_SPEED_FS:
-            if (increase) {
-                if (systemParams.speedFullScale >= 5000) {
-                    limitReached = true;
-                } else {
-                    systemParams.speedFullScale += STEP_SPEED;
-                }
-            } else {
-                if (systemParams.speedFullScale <= 100) {
-                    limitReached = true;
-                } else {
-                    systemParams.speedFullScale = max(100, systemParams.speedFullScale - STEP_SPEED);
-                }
-            }
-            break;
-            
-        case ITEM_PID_P:
-            systemParams.kp += increase ? STEP_SMALL : -STEP_SMALL;
-            if (systemParams.kp < 0.0f) systemParams.kp = 0.0f;
-            break;
-            
-        case ITEM_PID_I:
-            systemParams.ki += increase ? STEP_SMALL : -STEP_SMALL;
-            if (systemParams.ki < 0.0f) systemParams.ki = 0.0f;
-            break;
-            
-        case ITEM_PID_D:
-            systemParams.kd += increase ? STEP_SMALL : -STEP_SMALL;
-            if (systemParams.kd < 0.0f) systemParams.kd = 0.0f;
-            break;
-            
-        default:
-            break;
+// Adjust value being edited, within the limits of its descriptor
+void adjustValue(bool increase, uint8_t multiplier) {
+    MenuEntry entry;
+    MenuParam param;
+
+    getMenuEntry(selectedItem, entry);
+    if (entry.action != ACTION_EDIT) {
+        return;
     }
-    
-    if (limitReached) {
-        showMessage("Limit reached!");
+    getMenuParam(entry.arg, param);
+
+    float step = param.step;
+    if (param.format != FORMAT_CHOICE) {
+        step *= multiplier;
+    }
+    float value = readParamValue(param) + (increase ? step : -step);
+
+    if (param.format == FORMAT_CHOICE) {
+        // Choices wrap around
+        if (value > param.maxValue) value = param.minValue;
+        if (value < param.minValue) value = param.maxValue;
+    } else if (value > param.maxValue + step / 2 ||
+               value < param.minValue - step / 2) {
+        showMessage(F("Limit reached!"));
+        value = constrain(value, param.minValue, param.maxValue);
+    }
+
+    writeParamValue(param, value);
+    if (isParamStored(entry.arg)) {
+        hasUnsavedChanges = true;
     }
-    hasUnsavedChanges = true;
 }
 
 // Reset to defaults
@@ -409,9 +592,18 @@ void resetToDefaults() {
     systemParams.kp = DEFAULT_KP;
     systemParams.ki = DEFAULT_KI;
     systemParams.kd = DEFAULT_KD;
+    systemParams.stopMode = DEFAULT_STOP_MODE;
+    systemParams.syncMode = DEFAULT_SYNC_MODE;
+    systemParams.speedFilter = DEFAULT_SPEED_FILTER;
+    systemParams.currentFilter = DEFAULT_CURRENT_FILTER;
+    systemParams.syncRatio = DEFAULT_SYNC_RATIO;
+    systemParams.syncTrim = DEFAULT_SYNC_TRIM;
+    systemParams.ledBarMode = DEFAULT_LED_BAR_MODE;
+    systemParams.setpointSource = DEFAULT_SETPOINT_SOURCE;
     saveParameters();
     updatePIDParameters();
-    showMessage("Reset to defaults");
+    updateScaling();
+    showMessage(F("Reset to defaults"));
 }
 
 // Handle calibration
@@ -420,14 +612,15 @@ void handleCalibration() {
     
     switch(calibrationStep) {
         case 0:
-            showPopup("Calibration", "Remove load", true);
+            showPopup(F("Calibration"), F("Remove load"), true);
             break;
         case 1:
-            showPopup("Calibration", "Apply full load", true);
+            showPopup(F("Calibration"), F("Apply full load"), true);
             break;
         case 2:
-            showPopup("Calibration", "Calibration done!", false);
+            showPopup(F("Calibration"), F("Calibration done!"), false);
             calibrationStep = 0;
+            openPage(MENU_SETTINGS, MENU_CALIBRATION);
             return;
     }
     calibrationStep++;
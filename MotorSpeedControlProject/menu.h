@@ -1,41 +1,186 @@
 /*
  * Menu system declarations for DC Motor Speed Control Project
+ *
+ * The menu is driven by two descriptor tables kept in flash: the parameter
+ * table describes every editable value (binding, limits, step and format),
+ * the entry table lists the items of each page in display order. Both are
+ * generated from the lists below, so adding a parameter or a page item only
+ * takes one line.
  */
 
 #ifndef MENU_H
 #define MENU_H
 
 #include <stdint.h>
-#include <debounce.h>
+#include <Arduino.h>  // For Print
 #include "config.h"
 #include "pid.h"
+#include "speed_sync.h"  // For SYNC_TRIM_LIMIT
+#include "filters.h"     // For FILTER_IIR_SHIFT_MAX
+#include "led_bar.h"     // For LedBarMode
+#include "setpoint.h"    // For SETPOINT_SOURCE_MAX
 
-// Menu states
+// Menu states (pages)
 enum MenuState {
     MENU_MAIN,
     MENU_SETTINGS,
     MENU_PID,
     MENU_CALIBRATION,
+    MENU_EVENT_LOG,
+    MENU_COUNTERS,
+    MENU_SYNC,
+    MENU_DIAGNOSTICS,
     MENU_NONE
 };
 
-// Menu items
+// Menu entry actions
+enum MenuAction {
+    ACTION_PAGE,         // Open page arg
+    ACTION_BACK,         // Return to the parent page
+    ACTION_EDIT,         // Edit parameter arg
+    ACTION_START,        // Start the motor
+    ACTION_STOP,         // Stop the motor
+    ACTION_RESET,        // Reset parameters to defaults
+    ACTION_CALIBRATION,  // Start calibration
+    ACTION_PROGRAM       // Run the speed program
+};
+
+// Menu entry visibility
+enum MenuVisibility {
+    SHOW_ALWAYS,
+    SHOW_STOPPED,        // Only while the motor is stopped
+    SHOW_RUNNING,        // Only while the motor is running
+    SHOW_MULTI_AXIS      // Only with more than one axis
+};
+
+// Parameter storage types
+enum ParamType {
+    PARAM_FLOAT,
+    PARAM_INT,
+    PARAM_UINT8
+};
+
+// Parameter display formats
+enum ParamFormat {
+    FORMAT_INT,          // 1234
+    FORMAT_DEC1,         // 12.3
+    FORMAT_DEC2,         // 1.23
+    FORMAT_CHOICE        // Option name from a '|' separated list
+};
+
+// Editable parameters:
+//   X(id, variable, type, format, min, max, step, unit or choices)
+#define MENU_PARAM_LIST(X) \
+    X(PARAM_CURRENT_FS, systemParams.currentFullScale, PARAM_FLOAT, FORMAT_DEC1,   1.0f,  50.0f, 1.0f,   "A") \
+    X(PARAM_SPEED_FS,   systemParams.speedFullScale,   PARAM_INT,   FORMAT_INT,    100,   5000,  100,    "RPM") \
+    X(PARAM_KP,         systemParams.kp,               PARAM_FLOAT, FORMAT_DEC2,   0.0f,  99.0f, 0.1f,   "") \
+    X(PARAM_KI,         systemParams.ki,               PARAM_FLOAT, FORMAT_DEC2,   0.0f,  99.0f, 0.01f,  "") \
+    X(PARAM_KD,         systemParams.kd,               PARAM_FLOAT, FORMAT_DEC2,   0.0f,  99.0f, 0.01f,  "") \
+    X(PARAM_STOP_MODE,  systemParams.stopMode,         PARAM_UINT8, FORMAT_CHOICE, STOP_MODE_COAST, STOP_MODE_RAMP, 1, "Coast|Ramp") \
+    X(PARAM_AXIS,       selectedAxis,                  PARAM_UINT8, FORMAT_CHOICE, 0, AXIS_COUNT - 1, 1, "1|2|3|4") \
+    X(PARAM_SYNC_MODE,  systemParams.syncMode,         PARAM_UINT8, FORMAT_CHOICE, SYNC_OFF, SYNC_FOLLOWER, 1, "Off|Master|Follow") \
+    X(PARAM_SYNC_RATIO, systemParams.syncRatio,        PARAM_FLOAT, FORMAT_DEC2,   0.1f,  10.0f, 0.01f,  "") \
+    X(PARAM_SYNC_TRIM,  systemParams.syncTrim,         PARAM_INT,   FORMAT_INT,    -SYNC_TRIM_LIMIT, SYNC_TRIM_LIMIT, 10, "RPM") \
+    X(PARAM_SPEED_FLT,  systemParams.speedFilter,      PARAM_UINT8, FORMAT_CHOICE, 0, FILTER_IIR_SHIFT_MAX, 1, "Off|2|4|8|16|32|64") \
+    X(PARAM_CURR_FLT,   systemParams.currentFilter,    PARAM_UINT8, FORMAT_CHOICE, 0, FILTER_IIR_SHIFT_MAX, 1, "Off|2|4|8|16|32|64") \
+    X(PARAM_LED_MODE,   systemParams.ledBarMode,       PARAM_UINT8, FORMAT_CHOICE, LED_BAR_SPEED, LED_BAR_ERROR, 1, "Speed|Current|Error") \
+    X(PARAM_SP_SOURCE,  systemParams.setpointSource,   PARAM_UINT8, FORMAT_CHOICE, SOURCE_LOCAL, SETPOINT_SOURCE_MAX, 1, "Local|Serial|Freq|Analog")
+
+// Menu entries, in display order within each page:
+//   X(id, page, label, action, arg, visibility)
+#define MENU_ENTRY_LIST(X) \
+    X(ITEM_AXIS,          MENU_MAIN,     "Axis",         ACTION_EDIT,        PARAM_AXIS,       SHOW_MULTI_AXIS) \
+    X(ITEM_RUN,           MENU_MAIN,     "Run",          ACTION_START,       0,                SHOW_STOPPED) \
+    X(ITEM_STOP,          MENU_MAIN,     "Stop",         ACTION_STOP,        0,                SHOW_RUNNING) \
+    X(ITEM_PROGRAM,       MENU_MAIN,     "Program",      ACTION_PROGRAM,     0,                SHOW_STOPPED) \
+    X(ITEM_SETTINGS,      MENU_MAIN,     "Settings",     ACTION_PAGE,        MENU_SETTINGS,    SHOW_ALWAYS) \
+    X(ITEM_BACK,          MENU_MAIN,     "Back",         ACTION_BACK,        0,                SHOW_ALWAYS) \
+    X(ITEM_CURRENT_FS,    MENU_SETTINGS, "Curr. FS",     ACTION_EDIT,        PARAM_CURRENT_FS, SHOW_ALWAYS) \
+    X(ITEM_SPEED_FS,      MENU_SETTINGS, "Speed FS",     ACTION_EDIT,        PARAM_SPEED_FS,   SHOW_ALWAYS) \
+    X(ITEM_PID,           MENU_SETTINGS, "PID Settings", ACTION_PAGE,        MENU_PID,         SHOW_ALWAYS) \
+    X(ITEM_STOP_MODE,     MENU_SETTINGS, "Stop",         ACTION_EDIT,        PARAM_STOP_MODE,  SHOW_ALWAYS) \
+    X(ITEM_LED_MODE,      MENU_SETTINGS, "LED bar",      ACTION_EDIT,        PARAM_LED_MODE,   SHOW_ALWAYS) \
+    X(ITEM_SP_SOURCE,     MENU_SETTINGS, "Source",       ACTION_EDIT,        PARAM_SP_SOURCE,  SHOW_ALWAYS) \
+    X(ITEM_SYNC,          MENU_SETTINGS, "Sync",         ACTION_PAGE,        MENU_SYNC,        SHOW_ALWAYS) \
+    X(ITEM_EVENT_LOG,     MENU_SETTINGS, "Event Log",    ACTION_PAGE,        MENU_EVENT_LOG,   SHOW_ALWAYS) \
+    X(ITEM_COUNTERS,      MENU_SETTINGS, "Counters",     ACTION_PAGE,        MENU_COUNTERS,    SHOW_ALWAYS) \
+    X(ITEM_DIAGNOSTICS,   MENU_SETTINGS, "Diagnostics",  ACTION_PAGE,        MENU_DIAGNOSTICS, SHOW_ALWAYS) \
+    X(ITEM_CALIBRATION,   MENU_SETTINGS, "Calibration",  ACTION_CALIBRATION, 0,                SHOW_STOPPED) \
+    X(ITEM_RESET,         MENU_SETTINGS, "Reset",        ACTION_RESET,       0,                SHOW_STOPPED) \
+    X(ITEM_SETTINGS_BACK, MENU_SETTINGS, "Back",         ACTION_BACK,        0,                SHOW_ALWAYS) \
+    X(ITEM_PID_P,         MENU_PID,      "Kp",           ACTION_EDIT,        PARAM_KP,         SHOW_ALWAYS) \
+    X(ITEM_PID_I,         MENU_PID,      "Ki",           ACTION_EDIT,        PARAM_KI,         SHOW_ALWAYS) \
+    X(ITEM_PID_D,         MENU_PID,      "Kd",           ACTION_EDIT,        PARAM_KD,         SHOW_ALWAYS) \
+    X(ITEM_SPEED_FLT,     MENU_PID,      "Speed flt",    ACTION_EDIT,        PARAM_SPEED_FLT,  SHOW_ALWAYS) \
+    X(ITEM_CURR_FLT,      MENU_PID,      "Curr. flt",    ACTION_EDIT,        PARAM_CURR_FLT,   SHOW_ALWAYS) \
+    X(ITEM_PID_BACK,      MENU_PID,      "Back",         ACTION_BACK,        0,                SHOW_ALWAYS) \
+    X(ITEM_SYNC_MODE,     MENU_SYNC,     "Mode",         ACTION_EDIT,        PARAM_SYNC_MODE,  SHOW_ALWAYS) \
+    X(ITEM_SYNC_RATIO,    MENU_SYNC,     "Ratio",        ACTION_EDIT,        PARAM_SYNC_RATIO, SHOW_ALWAYS) \
+    X(ITEM_SYNC_TRIM,     MENU_SYNC,     "Trim",         ACTION_EDIT,        PARAM_SYNC_TRIM,  SHOW_ALWAYS) \
+    X(ITEM_SYNC_BACK,     MENU_SYNC,     "Back",         ACTION_BACK,        0,                SHOW_ALWAYS)
+
+#define MENU_ENUM_ID(id, ...) id,
+
+// Parameter identifiers
+enum MenuParamId {
+    MENU_PARAM_LIST(MENU_ENUM_ID)
+    MENU_PARAM_COUNT
+};
+
+// Menu items, one per entry table row
 enum MenuItem {
-    ITEM_RUN,
-    ITEM_STOP,
-    ITEM_SETTINGS,
-    ITEM_BACK,
-    ITEM_CURRENT_FS,
-    ITEM_SPEED_FS,
-    ITEM_PID_P,
-    ITEM_PID_I,
-    ITEM_PID_D,
-    ITEM_RESET,      // Reset to defaults
-    ITEM_CALIBRATION // Start calibration
-};
-
-// Button debounce
-const unsigned long DEBOUNCE_DELAY = 50;
+    MENU_ENTRY_LIST(MENU_ENUM_ID)
+    MENU_ITEM_COUNT
+};
+
+// Page of every entry, only used at compile time to size page buffers
+#define MENU_ENTRY_PAGE(id, page, ...) page,
+constexpr uint8_t MENU_ENTRY_PAGES[MENU_ITEM_COUNT] = {
+    MENU_ENTRY_LIST(MENU_ENTRY_PAGE)
+};
+
+constexpr uint8_t countPageEntries(uint8_t page, uint8_t item = 0) {
+    return item == MENU_ITEM_COUNT ? 0 :
+           (MENU_ENTRY_PAGES[item] == page) + countPageEntries(page, item + 1);
+}
+
+constexpr uint8_t largerPage(uint8_t page, uint8_t largest) {
+    return countPageEntries(page) > largest ? countPageEntries(page) : largest;
+}
+
+constexpr uint8_t largestPageEntries(uint8_t page = 0) {
+    return page == MENU_NONE ? 0 : largerPage(page, largestPageEntries(page + 1));
+}
+
+// Largest number of entries on one page, so a page never truncates
+const uint8_t MENU_MAX_PAGE_ITEMS = largestPageEntries();
+
+// Parameter descriptor (flash)
+struct MenuParam {
+    void* value;         // Bound variable
+    uint8_t type;        // ParamType
+    uint8_t format;      // ParamFormat
+    float minValue;
+    float maxValue;
+    float step;
+    const char* unit;    // Unit suffix or choices, in flash
+};
+
+// Menu entry descriptor (flash)
+struct MenuEntry {
+    const char* label;   // Label, in flash
+    uint8_t page;        // MenuState the entry belongs to
+    uint8_t action;      // MenuAction
+    uint8_t arg;         // Target page or MenuParamId
+    uint8_t visibility;  // MenuVisibility
+};
+
+// UP/DOWN auto-repeat
+const unsigned long REPEAT_DELAY = 500;     // Hold time before repeating in ms
+const unsigned long REPEAT_INTERVAL = 100;  // Repeat period in ms
+const uint8_t REPEAT_ACCEL_COUNT = 5;       // Repeats before the step doubles
+const uint8_t REPEAT_MAX_SHIFT = 4;         // Largest step multiplier is 1 << 4
+
 
 // External declarations
 extern MenuState currentMenu;
@@ -44,6 +189,7 @@ extern unsigned long lastMenuActivity;
 extern bool editingValue;
 extern unsigned long lastButtonPress;
 extern bool hasUnsavedChanges;  // Solo dichiarazione extern
+extern uint8_t eventLogView;    // First event log entry shown
 
 // Function declarations
 void resetToDefaults();
@@ -55,6 +201,12 @@ void processMenu();
 void handleMenuSelection();
 void handleBackButton();
 void navigateMenu(bool up);
-void adjustValue(bool increase);
+void adjustValue(bool increase, uint8_t multiplier = 1);
+
+// Descriptor table access
+void getMenuEntry(MenuItem item, MenuEntry& entry);
+void getMenuParam(uint8_t id, MenuParam& param);
+uint8_t getMenuPageItems(MenuState page, MenuItem* items);
+void printParamValue(Print& out, uint8_t id);
 
-#endif 
\ No newline at end of file
+#endif
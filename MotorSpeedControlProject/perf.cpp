@@ -0,0 +1,146 @@
+/*
+ * Performance measurement implementation for DC Motor Speed Control Project
+ */
+
+#include "perf.h"
+#include <util/atomic.h>
+#include "globals.h"
+#include "tick.h"     // For tickCount
+#include "axis.h"     // For activeAxis()
+
+static CycleStats cycleStats[PERF_SECTION_COUNT];
+static ControlMetrics metrics;
+static uint8_t metricsAxis = 0;           // Axis the metrics belong to
+static bool metricsRunning = false;       // Axis was running on the last update
+
+// CPU cycles since the tick started; wraps after about 4.4 minutes, which
+// only matters for intervals longer than that
+uint32_t readCycles() {
+    uint32_t ticks;
+    uint16_t count;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        ticks = tickCount;
+        count = TCB2.CNT;
+        // Account for a tick that is pending but not yet serviced
+        if (TCB2.INTFLAGS & TCB_CAPT_bm) {
+            ticks++;
+            count = TCB2.CNT;
+        }
+    }
+    return ticks * (F_CPU / TICK_FREQUENCY) + count;
+}
+
+// Add the cycles since startCycles to a section
+void recordCycles(PerfSection section, uint32_t startCycles) {
+    uint32_t cycles = readCycles() - startCycles;
+    CycleStats& stats = cycleStats[section];
+
+    stats.calls++;
+    stats.totalCycles += cycles;
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+}
+
+// Start a new response window at the current setpoint
+static void startMetrics(uint16_t from, uint16_t to) {
+    memset(&metrics, 0, sizeof(metrics));
+    metrics.stepFrom = from;
+    metrics.stepTo = to;
+    metrics.stepTime = millis();
+}
+
+// Integrate the response of the active axis, called every loop pass
+void updateControlMetrics() {
+    static unsigned long lastUpdate = 0;
+    unsigned long currentMillis = millis();
+    unsigned long elapsed = currentMillis - lastUpdate;
+
+    if (elapsed < METRICS_UPDATE_INTERVAL) {
+        return;
+    }
+    lastUpdate = currentMillis;
+
+    const MotorAxis& axis = activeAxis();
+    uint16_t setpoint = axis.pidSetpoint;
+    bool running = isMotorRunning(axis) || axis.state == STATE_ALARM;
+
+    // A start, an axis change or a setpoint change opens a new window
+    if (getAxisIndex(axis) != metricsAxis || (running && !metricsRunning)) {
+        metricsAxis = getAxisIndex(axis);
+        startMetrics(0, setpoint);
+    } else if (setpoint != metrics.stepTo) {
+        startMetrics(metrics.stepTo, setpoint);
+    }
+    metricsRunning = running;
+
+    if (!running) {
+        return;
+    }
+    if (axis.state == STATE_ALARM) {
+        metrics.alarmMs += elapsed;
+        return;
+    }
+
+    int16_t error = (int16_t)setpoint - (int16_t)axis.speed;
+    float dt = elapsed / 1000.0;
+    metrics.iae += abs(error) * dt;
+    metrics.ise += (float)error * error * dt;
+
+    // Overshoot: excursion past the target in the direction of the step
+    int16_t excursion = metrics.stepTo >= metrics.stepFrom ? -error : error;
+    if (excursion > (int16_t)metrics.overshoot) {
+        metrics.overshoot = excursion;
+    }
+
+    uint16_t step = abs((int16_t)metrics.stepTo - (int16_t)metrics.stepFrom);
+    uint16_t band = (uint32_t)step * SETTLING_BAND_PERCENT / 100;
+    if (band < SETTLING_BAND_MIN) {
+        band = SETTLING_BAND_MIN;
+    }
+    if ((uint16_t)abs(error) > band) {
+        metrics.settlingMs = currentMillis - metrics.stepTime;
+    }
+}
+
+// Clear the cycle statistics and restart the response window
+void resetPerf() {
+    memset(cycleStats, 0, sizeof(cycleStats));
+    startMetrics(metrics.stepTo, metrics.stepTo);
+}
+
+static void printCycleStats(Print& out, const __FlashStringHelper* name, const CycleStats& stats) {
+    out.print(name);
+    out.print(F("_calls="));
+    out.println(stats.calls);
+    out.print(name);
+    out.print(F("_avg_cycles="));
+    out.println(stats.calls ? stats.totalCycles / stats.calls : 0);
+    out.print(name);
+    out.print(F("_max_cycles="));
+    out.println(stats.maxCycles);
+}
+
+// Print response metrics and cycle statistics as key=value lines
+void printPerf(Print& out) {
+    out.print(F("step_from_rpm="));
+    out.println(metrics.stepFrom);
+    out.print(F("step_to_rpm="));
+    out.println(metrics.stepTo);
+    out.print(F("window_ms="));
+    out.println(millis() - metrics.stepTime);
+    out.print(F("iae_rpm_s="));
+    out.println(metrics.iae, 0);
+    out.print(F("ise_rpm2_s="));
+    out.println(metrics.ise, 0);
+    out.print(F("overshoot_rpm="));
+    out.println(metrics.overshoot);
+    out.print(F("settling_ms="));
+    out.println(metrics.settlingMs);
+    out.print(F("alarm_ms="));
+    out.println(metrics.alarmMs);
+    printCycleStats(out, F("read_inputs"), cycleStats[PERF_READ_INPUTS]);
+    printCycleStats(out, F("process_pid"), cycleStats[PERF_PROCESS_PID]);
+    printCycleStats(out, F("plant_id"), cycleStats[PERF_PLANT_ID]);
+}
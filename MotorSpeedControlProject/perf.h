@@ -0,0 +1,59 @@
+/*
+ * Performance measurement declarations for DC Motor Speed Control Project
+ *
+ * Two kinds of figures are kept on the target itself:
+ * - CPU cycles spent in the control core, read from the 1 kHz tick count
+ *   and the TCB2 counter (one count per CPU cycle)
+ * - control quality of the active axis since its last setpoint step: IAE,
+ *   ISE, overshoot, settling time and time in alarm
+ * Both are printed as key=value lines by the PERF serial command, and STEP
+ * applies a setpoint step so a response can be repeated exactly.
+ */
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+
+// Measured code sections
+enum PerfSection {
+    PERF_READ_INPUTS,
+    PERF_PROCESS_PID,
+    PERF_PLANT_ID,
+    PERF_SECTION_COUNT
+};
+
+// Cycle statistics of one section
+struct CycleStats {
+    uint32_t calls;
+    uint32_t totalCycles;
+    uint32_t maxCycles;
+};
+
+// Response metrics since the last setpoint step
+struct ControlMetrics {
+    uint16_t stepFrom;        // Setpoint before the step in RPM
+    uint16_t stepTo;          // Setpoint after the step in RPM
+    unsigned long stepTime;   // Time of the step
+    float iae;                // Integral of |error| in RPM*s
+    float ise;                // Integral of error^2 in RPM^2*s
+    uint16_t overshoot;       // Largest excursion past the target in RPM
+    unsigned long settlingMs; // Last time the error left the band, from the step
+    unsigned long alarmMs;    // Time in alarm since the step
+};
+
+// Settling band: 2% of the step, at least SETTLING_BAND_MIN
+const uint8_t SETTLING_BAND_PERCENT = 2;
+const uint16_t SETTLING_BAND_MIN = 10;            // RPM
+const unsigned long METRICS_UPDATE_INTERVAL = 10; // Metrics integration period in ms
+
+// Function declarations
+uint32_t readCycles();
+void recordCycles(PerfSection section, uint32_t startCycles);
+void updateControlMetrics();
+void resetPerf();
+void printPerf(Print& out);
+
+#endif
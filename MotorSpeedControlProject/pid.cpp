@@ -5,46 +5,103 @@
 #include "pid.h"
 #include "pins.h"
 #include "globals.h"
+#include "axis.h"
+#include "plant_id.h"  // For queuePlantSample()
 
-// Function to update PID parameters
+void initializeController(SpeedController& pid) {
+    memset(&pid, 0, sizeof(pid));
+}
+
+// Change gains without a step in the output: the integral takes up the
+// change of the proportional and derivative terms at the last error
+void setControllerGains(SpeedController& pid, float kp, float ki, float kd) {
+    if (pid.active) {
+        float derivative = pid.kd > 0 ? pid.derivative * kd / pid.kd : 0;
+        pid.integral += (pid.kp - kp) * pid.lastError + pid.derivative - derivative;
+        pid.derivative = derivative;
+    }
+    pid.kp = kp;
+    pid.ki = ki;
+    pid.kd = kd;
+}
+
+// Close the loop with the integral preloaded so the first output equals output
+void startController(SpeedController& pid, float output, float setpoint, float input) {
+    pid.lastError = setpoint - input;
+    pid.lastInput = input;
+    pid.derivative = 0;
+    pid.integral = output - pid.kp * pid.lastError;
+    pid.active = true;
+}
+
+// One controller step, dt in s
+float computeController(SpeedController& pid, float setpoint, float input, float dt) {
+    float error = setpoint - input;
+
+    // Derivative of the measurement, first-order low-pass
+    pid.derivative = (PID_D_FILTER_TIME * pid.derivative - pid.kd * (input - pid.lastInput)) /
+                     (PID_D_FILTER_TIME + dt);
+
+    float unclamped = pid.kp * error + pid.integral + pid.derivative;
+    float output = constrain(unclamped, PID_OUTPUT_MIN, PID_OUTPUT_MAX);
+
+    // Integrate, tracking the saturated output at about the integral rate
+    float trackingRate = pid.kp > 0 ? pid.ki / pid.kp : 0;
+    if (trackingRate < PID_TRACKING_RATE_MIN) {
+        trackingRate = PID_TRACKING_RATE_MIN;
+    }
+    pid.integral += (pid.ki * error + trackingRate * (output - unclamped)) * dt;
+
+    pid.lastInput = input;
+    pid.lastError = error;
+    return output;
+}
+
+// Function to update PID parameters of all axes
 void updatePIDParameters() {
-    motorPID.SetTunings(systemParams.kp, systemParams.ki, systemParams.kd);
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        setControllerGains(axes[i].pid, systemParams.kp, systemParams.ki, systemParams.kd);
+    }
+}
+
+// Function to open the loop with the output at zero
+void resetPID(MotorAxis& axis) {
+    axis.pid.active = false;
+    axis.pidOutput = 0;
 }
 
-// Function to reset PID controller
-void resetPID() {
-    motorPID.SetMode(MANUAL);
-    pidOutput = 0;
-    motorPID.SetMode(AUTOMATIC);
+// Function to switch to closed loop starting from the current output. At the
+// end of the soft start this is the feedforward estimate for the setpoint.
+void startPID(MotorAxis& axis) {
+    startController(axis.pid, axis.pidOutput, axis.pidSetpoint, axis.speed);
+    axis.lastPIDCompute = millis();
+}
+
+// Open loop output estimate for the setpoint, assuming speed proportional to PWM
+float getFeedforward(const MotorAxis& axis) {
+    return axis.pidSetpoint * PID_OUTPUT_MAX / systemParams.speedFullScale;
 }
 
 // Function to process PID control
-void processPID() {
-    static unsigned long lastPIDCompute = 0;
+void processPID(MotorAxis& axis) {
     unsigned long currentMillis = millis();
+    unsigned long elapsed = currentMillis - axis.lastPIDCompute;
     
-    if (currentState == STATE_RUN && 
-        (currentMillis - lastPIDCompute >= PID_COMPUTE_INTERVAL)) {
-        
-        // Update input
-        pidInput = currentSpeed;
-        
-        // Compute new output
-        if (motorPID.Compute()) {
-            // Apply output only if not in alarm state
-            if (currentState != STATE_ALARM) {
-                analogWrite(MOTOR_PWM_PIN, pidOutput);
-            }else{
-                analogWrite(MOTOR_PWM_PIN, 0);
-            }
-        }
-        
-        lastPIDCompute = currentMillis;
+    if (axis.state == STATE_RUN && axis.pid.active && elapsed >= PID_COMPUTE_INTERVAL) {
+        // Steps longer than a few intervals (a stalled loop) count as one interval
+        float dt = (elapsed > 4 * PID_COMPUTE_INTERVAL ? PID_COMPUTE_INTERVAL : elapsed) / 1000.0;
+
+        axis.pidOutput = computeController(axis.pid, axis.pidSetpoint, axis.speed, dt);
+        setMotorPwm(axis, axis.pidOutput);
+        axis.lastPIDCompute = currentMillis;
+
+        // Speed and the output applied since the last step, for the plant fit
+        queuePlantSample(axis);
     }
 }
 
-// Function to set speed setpoint
-void setSpeedSetpoint(double newSetpoint) {
+// Function to set the local speed setpoint (see setpoint.h)
+void setSpeedSetpoint(MotorAxis& axis, double newSetpoint) {
     // Limit setpoint to valid range
     if (newSetpoint < 0) {
         newSetpoint = 0;
@@ -52,19 +109,19 @@ void setSpeedSetpoint(double newSetpoint) {
         newSetpoint = systemParams.speedFullScale;
     }
     
-    pidSetpoint = newSetpoint;
+    axis.localSetpoint = newSetpoint;
 }
 
 // Function to adjust setpoint incrementally
-void adjustSetpoint(bool increase) {
+void adjustSetpoint(MotorAxis& axis, bool increase, uint8_t multiplier) {
     const double SETPOINT_STEP = 50.0;  // RPM
-    double newSetpoint = pidSetpoint;
+    double newSetpoint = axis.localSetpoint;
     
     if (increase) {
-        newSetpoint += SETPOINT_STEP;
+        newSetpoint += SETPOINT_STEP * multiplier;
     } else {
-        newSetpoint -= SETPOINT_STEP;
+        newSetpoint -= SETPOINT_STEP * multiplier;
     }
     
-    setSpeedSetpoint(newSetpoint);
-} 
\ No newline at end of file
+    setSpeedSetpoint(axis, newSetpoint);
+}
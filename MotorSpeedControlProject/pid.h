@@ -1,11 +1,18 @@
 /*
  * PID control declarations for DC Motor Speed Control Project
+ *
+ * Speed controller in parallel form with:
+ * - derivative on the measurement, low-pass filtered with PID_D_FILTER_TIME
+ * - back-calculation anti-windup: while the output saturates the integral
+ *   is pulled back by the excess at the tracking rate
+ * - bumpless start and gain changes: the integral absorbs any step of the
+ *   proportional and derivative terms
+ * The integral is kept in output units, so a change of Ki alone is bumpless.
  */
 
 #ifndef PID_H
 #define PID_H
 
-#include <PID_v1.h>
 #include "config.h"
 #include "states.h"
 
@@ -16,11 +23,31 @@ const unsigned long PID_COMPUTE_INTERVAL = 10;  // 10ms = 100Hz control loop
 const int PID_OUTPUT_MIN = 0;
 const int PID_OUTPUT_MAX = 255;  // 8-bit PWM
 
+// Controller tuning
+const float PID_D_FILTER_TIME = 0.03;         // Derivative low-pass time constant in s
+const float PID_TRACKING_RATE_MIN = 2.0;      // Anti-windup tracking rate floor in 1/s
+
+// Controller state of one axis
+struct SpeedController {
+    float kp, ki, kd;        // Gains, ki in 1/s and kd in s
+    float integral;          // Integral term in output units
+    float derivative;        // Filtered derivative term in output units
+    float lastInput;         // Measurement of the previous step
+    float lastError;
+    bool active;             // Closed loop, false while the output is set by the state machine
+};
+
 // Function declarations
+void initializeController(SpeedController& pid);
+void setControllerGains(SpeedController& pid, float kp, float ki, float kd);
+void startController(SpeedController& pid, float output, float setpoint, float input);
+float computeController(SpeedController& pid, float setpoint, float input, float dt);
 void updatePIDParameters();
-void resetPID();
-void processPID();
-void setSpeedSetpoint(double newSetpoint);
-void adjustSetpoint(bool increase);
+void resetPID(MotorAxis& axis);
+void startPID(MotorAxis& axis);
+float getFeedforward(const MotorAxis& axis);
+void processPID(MotorAxis& axis);
+void setSpeedSetpoint(MotorAxis& axis, double newSetpoint);
+void adjustSetpoint(MotorAxis& axis, bool increase, uint8_t multiplier = 1);
 
-#endif 
\ No newline at end of file
+#endif
@@ -5,6 +5,14 @@
 #include "pins.h"
 
 void initializePins() {
+    // Drive the motors off first: after a reset the PWM pins float until here
+    for(uint8_t i = 0; i < AXIS_COUNT; i++) {
+        pinMode(AXIS_PINS[i].pwm, OUTPUT);
+        analogWrite(AXIS_PINS[i].pwm, 0);
+        pinMode(AXIS_PINS[i].currentSense, INPUT);
+        pinMode(AXIS_PINS[i].speedSense, INPUT);
+    }
+    
     // Initialize LED bar pins
     for(uint8_t i = 0; i < LED_BAR_COUNT; i++) {
         pinMode(LED_BAR_PINS[i], OUTPUT);
@@ -25,12 +33,4 @@ void initializePins() {
     pinMode(RGB_RED_PIN, OUTPUT);
     pinMode(RGB_GREEN_PIN, OUTPUT);
     pinMode(RGB_BLUE_PIN, OUTPUT);
-    
-    // Initialize motor PWM pin
-    pinMode(MOTOR_PWM_PIN, OUTPUT);
-    analogWrite(MOTOR_PWM_PIN, 0);
-    
-    // Initialize analog inputs
-    pinMode(CURRENT_SENSE_PIN, INPUT);
-    pinMode(SPEED_SENSE_PIN, INPUT);
 } 
\ No newline at end of file
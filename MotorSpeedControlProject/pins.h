@@ -7,16 +7,27 @@
 
 #include <stdint.h>
 #include <Arduino.h>  // For pinMode, digitalWrite, etc.
+#include "config.h"   // For FAST_OVERCURRENT_TRIP, EXTERNAL_SETPOINT_INPUT
 
 // LED Bar configuration
 //---------------------
+#if EXTERNAL_SETPOINT_INPUT
+const uint8_t LED_BAR_PINS[] = {2, 4, 7, 8, 11, 13};      // D12 is the setpoint input
+#else
 const uint8_t LED_BAR_PINS[] = {2, 4, 7, 8, 11, 12, 13};  // D2-D13 pins for LED bar
-const uint8_t LED_BAR_COUNT = 7;                          // Number of LEDs in bar
+#endif
+const uint8_t LED_BAR_COUNT = sizeof(LED_BAR_PINS);       // Number of LEDs in bar
 
 // Analog inputs
 //-------------
+#if FAST_OVERCURRENT_TRIP
+// The current sensor must be on a comparator input: A6 is PD4, AC0 AINP1
+const uint8_t CURRENT_SENSE_PIN = 20;  // A6: Current sensor input
+const uint8_t SPEED_SENSE_PIN = 21;    // A7: Speed sensor input
+#else
 const uint8_t CURRENT_SENSE_PIN = 21;  // A7: Current sensor input
 const uint8_t SPEED_SENSE_PIN = 20;    // A6: Speed sensor input
+#endif
 
 // User interface pins
 //------------------
@@ -36,6 +47,29 @@ const uint8_t RGB_BLUE_PIN = 6;     // RGB LED blue component (PWM)
 //------------
 const uint8_t MOTOR_PWM_PIN = 9;    // Motor PWM output
 
+// Speed sync link
+//------------
+// Serial1 on D0 (RX) and D1 (TX), see speed_sync.h
+
+// External setpoint inputs
+//------------
+const uint8_t SETPOINT_FREQUENCY_PIN = 0;  // D0: pulse input, shared with the sync link RX
+const uint8_t SETPOINT_ANALOG_PIN = 12;    // D12 (PE1, AIN9): 0-5 V input, with EXTERNAL_SETPOINT_INPUT
+
+// Motor axes
+//----------
+struct AxisPins {
+    uint8_t pwm;           // PWM output
+    uint8_t speedSense;    // Speed sensor input
+    uint8_t currentSense;  // Current sensor input
+};
+
+// One row per motor; add a row (and its PID in axis.cpp) for each extra axis
+const AxisPins AXIS_PINS[] = {
+    {MOTOR_PWM_PIN, SPEED_SENSE_PIN, CURRENT_SENSE_PIN}
+};
+const uint8_t AXIS_COUNT = sizeof(AXIS_PINS) / sizeof(AXIS_PINS[0]);
+
 // I2C pins (defined in Wire.h)
 // SDA = 18
 // SCL = 19
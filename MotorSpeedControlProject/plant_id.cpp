@@ -0,0 +1,223 @@
+/*
+ * Plant identification implementation for DC Motor Speed Control Project
+ */
+
+#include "plant_id.h"
+#include "globals.h"
+#include "axis.h"
+#include "pid.h"
+#include "eeprom_manager.h"  // For saveParameters()
+#include "event_log.h"       // For logPlantDrift()
+
+static PlantEstimator estimators[AXIS_COUNT];
+
+// Control step in s, the model sample time
+static const float PLANT_SAMPLE_TIME = PID_COMPUTE_INTERVAL / 1000.0;
+
+void initializePlantId() {
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        resetPlantEstimator(axes[i]);
+    }
+}
+
+// Restart the fit from a unit gain, 100 ms time constant guess
+void resetPlantEstimator(MotorAxis& axis) {
+    PlantEstimator& est = estimators[getAxisIndex(axis)];
+
+    memset(&est, 0, sizeof(est));
+    est.a = 0.9;
+    est.b = 0.1;
+    est.p11 = PLANT_COVARIANCE_INIT;
+    est.p22 = PLANT_COVARIANCE_INIT;
+}
+
+// Hand over the sample of the control step just taken; called by processPID()
+void queuePlantSample(MotorAxis& axis) {
+    PlantEstimator& est = estimators[getAxisIndex(axis)];
+    unsigned long currentMillis = millis();
+    float speed = (float)axis.speed / systemParams.speedFullScale;
+
+    // A sample only pairs with the previous one if the steps were regular;
+    // a pending sample not yet used is overwritten by the newer one
+    if (currentMillis - est.lastSampleTime <= PID_COMPUTE_INTERVAL * 3 / 2) {
+        est.sample[0] = est.lastSpeed;
+        est.sample[1] = est.lastOutput;
+        est.sample[2] = speed;
+        est.samplePending = true;
+    }
+    est.lastSpeed = speed;
+    est.lastOutput = axis.pidOutput / PID_OUTPUT_MAX;
+    est.lastSampleTime = currentMillis;
+}
+
+// One recursive least squares step
+static void updateEstimator(PlantEstimator& est) {
+    float y0 = est.sample[0];
+    float u0 = est.sample[1];
+    float y = est.sample[2];
+    est.samplePending = false;
+
+    float error = y - (est.a * y0 + est.b * u0);
+    if (fabs(error) < PLANT_ERROR_DEADBAND) {
+        return;
+    }
+
+    // Gain vector k = P phi / (lambda + phi' P phi)
+    float pPhi1 = est.p11 * y0 + est.p12 * u0;
+    float pPhi2 = est.p12 * y0 + est.p22 * u0;
+    float lambda = est.p11 + est.p22 < PLANT_COVARIANCE_MAX ? PLANT_FORGETTING : 1.0;
+    float denominator = lambda + y0 * pPhi1 + u0 * pPhi2;
+    float k1 = pPhi1 / denominator;
+    float k2 = pPhi2 / denominator;
+
+    est.a += k1 * error;
+    est.b += k2 * error;
+
+    // P = (P - k phi' P) / lambda
+    est.p11 = (est.p11 - k1 * pPhi1) / lambda;
+    est.p12 = (est.p12 - k1 * pPhi2) / lambda;
+    est.p22 = (est.p22 - k2 * pPhi2) / lambda;
+
+    if (est.updates < UINT16_MAX) {
+        est.updates++;
+    }
+}
+
+// Flag a departure from the stored baseline, once until the baseline changes
+static void checkDrift(MotorAxis& axis, PlantEstimator& est) {
+    PlantModel model;
+
+    if (est.drift || systemParams.plantGain <= 0 || !getPlantModel(axis, model)) {
+        return;
+    }
+
+    uint8_t flags = 0;
+    if (fabs(model.gain / systemParams.plantGain - 1) > PLANT_DRIFT_LIMIT) {
+        flags |= PLANT_DRIFT_GAIN;
+    }
+    if (fabs(model.tau / systemParams.plantTau - 1) > PLANT_DRIFT_LIMIT) {
+        flags |= PLANT_DRIFT_TAU;
+    }
+    if (flags) {
+        est.drift = true;
+        logPlantDrift(axis, flags);
+    }
+}
+
+// Background task: use at most one pending sample per call
+void updatePlantId() {
+    static uint8_t next = 0;
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        uint8_t index = (next + i) % AXIS_COUNT;
+        PlantEstimator& est = estimators[index];
+        if (est.samplePending) {
+            updateEstimator(est);
+            checkDrift(axes[index], est);
+            next = (index + 1) % AXIS_COUNT;
+            return;
+        }
+    }
+}
+
+// Model in engineering units, false until the fit has converged
+bool getPlantModel(const MotorAxis& axis, PlantModel& model) {
+    const PlantEstimator& est = estimators[getAxisIndex(axis)];
+
+    model.valid = est.updates >= PLANT_MIN_UPDATES &&
+                  est.p11 + est.p22 < PLANT_CONVERGED_TRACE &&
+                  est.a > 0 && est.a < 1 && est.b > 0;
+    if (model.valid) {
+        model.gain = est.b / (1 - est.a) * systemParams.speedFullScale / PID_OUTPUT_MAX;
+        model.tau = -PLANT_SAMPLE_TIME / log(est.a);
+    }
+    return model.valid;
+}
+
+bool isPlantDrifting(const MotorAxis& axis) {
+    return estimators[getAxisIndex(axis)].drift;
+}
+
+// Lambda tuning for a first-order plant
+bool suggestGains(const PlantModel& model, float& kp, float& ki, float& kd) {
+    if (!model.valid) {
+        return false;
+    }
+    kp = 1 / (model.gain * PLANT_TUNING_RATIO);
+    ki = kp / model.tau;
+    kd = 0;
+    return true;
+}
+
+// Store the current model as the drift baseline
+bool savePlantBaseline(const MotorAxis& axis) {
+    PlantModel model;
+
+    if (!getPlantModel(axis, model)) {
+        return false;
+    }
+    systemParams.plantGain = model.gain;
+    systemParams.plantTau = model.tau;
+    saveParameters();
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        estimators[i].drift = false;
+    }
+    return true;
+}
+
+// Take over the suggested gains; the controller change is bumpless
+bool applySuggestedGains(const MotorAxis& axis) {
+    PlantModel model;
+    float kp, ki, kd;
+
+    if (!getPlantModel(axis, model) || !suggestGains(model, kp, ki, kd)) {
+        return false;
+    }
+    systemParams.kp = kp;
+    systemParams.ki = ki;
+    systemParams.kd = kd;
+    updatePIDParameters();
+    saveParameters();
+    return true;
+}
+
+// Print a key of the form "axis2_name="
+static void printAxisKey(Print& out, uint8_t axis, const __FlashStringHelper* name) {
+    out.print(F("axis"));
+    out.print(axis + 1);
+    out.print(name);
+}
+
+// Print the model and suggested gains of every axis as key=value lines
+void printPlantId(Print& out) {
+    out.print(F("baseline_gain_rpm_per_pwm="));
+    out.println(systemParams.plantGain, 2);
+    out.print(F("baseline_tau_ms="));
+    out.println(systemParams.plantTau * 1000, 0);
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        const PlantEstimator& est = estimators[i];
+        PlantModel model;
+        float kp, ki, kd;
+
+        printAxisKey(out, i, F("_updates="));
+        out.println(est.updates);
+        printAxisKey(out, i, F("_valid="));
+        out.println(getPlantModel(axes[i], model) ? 1 : 0);
+        if (!suggestGains(model, kp, ki, kd)) {
+            continue;
+        }
+        printAxisKey(out, i, F("_gain_rpm_per_pwm="));
+        out.println(model.gain, 2);
+        printAxisKey(out, i, F("_tau_ms="));
+        out.println(model.tau * 1000, 0);
+        printAxisKey(out, i, F("_drift="));
+        out.println(est.drift ? 1 : 0);
+        printAxisKey(out, i, F("_suggest_kp="));
+        out.println(kp, 3);
+        printAxisKey(out, i, F("_suggest_ki="));
+        out.println(ki, 3);
+        printAxisKey(out, i, F("_suggest_kd="));
+        out.println(kd, 3);
+    }
+}
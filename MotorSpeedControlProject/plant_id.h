@@ -0,0 +1,70 @@
+/*
+ * Plant identification declarations for DC Motor Speed Control Project
+ *
+ * While an axis runs, its motor is fitted online to a first-order model
+ *   speed[k] = a * speed[k-1] + b * pwm[k-1]
+ * by recursive least squares with exponential forgetting. processPID() only
+ * hands over one regression sample per control step; the fit itself runs
+ * from loop() after the outputs are updated, at most one update per call,
+ * so it never delays the control task. Speed and PWM are normalized to
+ * their full scales to keep the float math well conditioned.
+ *
+ * From a and b follow the static gain K = b / (1 - a) and the time constant
+ * tau = -T / ln(a). They are compared with a stored baseline to flag drift,
+ * and give suggested gains by lambda tuning: Kp = 1 / (K * ratio),
+ * Ki = Kp / tau, Kd = 0, for a closed loop ratio times faster than tau.
+ */
+
+#ifndef PLANT_ID_H
+#define PLANT_ID_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+#include "states.h"
+
+// Estimator tuning
+const float PLANT_FORGETTING = 0.998;        // Memory of about 500 samples (5 s)
+const float PLANT_COVARIANCE_INIT = 100.0;   // Initial covariance diagonal
+const float PLANT_COVARIANCE_MAX = 1000.0;   // Forgetting stops above this trace
+const float PLANT_ERROR_DEADBAND = 0.002;    // Prediction errors below are noise
+const uint16_t PLANT_MIN_UPDATES = 200;      // Updates before the fit is used
+const float PLANT_CONVERGED_TRACE = 5.0;     // Largest covariance trace of a usable fit
+
+// Drift and tuning
+const float PLANT_DRIFT_LIMIT = 0.25;        // Relative change from the baseline
+const float PLANT_TUNING_RATIO = 0.5;        // Closed loop time constant / tau
+
+// Estimator state of one axis
+struct PlantEstimator {
+    float a, b;                  // Model parameters
+    float p11, p12, p22;         // Covariance, symmetric
+    float lastSpeed;             // Normalized speed of the previous control step
+    float lastOutput;            // Normalized output applied since then
+    unsigned long lastSampleTime;
+    float sample[3];             // Pending regression: speed[k-1], pwm[k-1], speed[k]
+    bool samplePending;
+    uint16_t updates;            // Updates since the last reset
+    bool drift;                  // Drift flagged, logged once
+};
+
+// Model of one axis in engineering units
+struct PlantModel {
+    bool valid;                  // Converged to a stable first-order model
+    float gain;                  // RPM per PWM count
+    float tau;                   // Time constant in s
+};
+
+// Function declarations
+void initializePlantId();
+void resetPlantEstimator(MotorAxis& axis);
+void queuePlantSample(MotorAxis& axis);
+void updatePlantId();
+bool getPlantModel(const MotorAxis& axis, PlantModel& model);
+bool isPlantDrifting(const MotorAxis& axis);
+bool suggestGains(const PlantModel& model, float& kp, float& ki, float& kd);
+bool savePlantBaseline(const MotorAxis& axis);
+bool applySuggestedGains(const MotorAxis& axis);
+void printPlantId(Print& out);
+
+#endif
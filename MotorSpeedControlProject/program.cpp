@@ -0,0 +1,307 @@
+/*
+ * Speed program implementation for DC Motor Speed Control Project
+ */
+
+#include "program.h"
+#include <EEPROM.h>
+#include "globals.h"
+#include "axis.h"
+#include "display.h" // For showMessage()
+
+// Program as stored in EEPROM
+struct StoredProgram {
+    uint8_t length;
+    uint8_t checksum;
+    ProgramStep steps[PROGRAM_MAX_STEPS];
+};
+static_assert(EEPROM_PROGRAM_ADDR + sizeof(StoredProgram) <= EEPROM_SIZE,
+              "StoredProgram must fit in the EEPROM");
+
+static StoredProgram program;
+
+// Runner state
+static ProgramStatus status = PROGRAM_IDLE;
+static uint8_t programAxis = 0;
+static uint8_t currentStep = 0;
+static unsigned long stepStart = 0;
+static unsigned long lastUpdate = 0;
+static double rampSetpoint = 0;
+static uint16_t loopDone[PROGRAM_MAX_STEPS];   // Repeats taken by each LOOP step
+
+static uint8_t programChecksum() {
+    const uint8_t* bytes = (const uint8_t*)program.steps;
+    uint8_t sum = 0x5A + program.length;
+    for (uint8_t i = 0; i < sizeof(program.steps); i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+// A step is valid at index if its op is known and a loop jumps backwards
+static bool isStepValid(const ProgramStep& step, uint8_t index) {
+    if (step.op > OP_STOP || step.op == OP_END) {
+        return false;
+    }
+    return step.op != OP_LOOP || step.arg < index;
+}
+
+// Load the saved program, empty if none or corrupt
+void initializeProgram() {
+    EEPROM.get(EEPROM_PROGRAM_ADDR, program);
+    bool valid = program.length <= PROGRAM_MAX_STEPS && program.checksum == programChecksum();
+    for (uint8_t i = 0; valid && i < program.length; i++) {
+        valid = isStepValid(program.steps[i], i);
+    }
+    if (!valid) {
+        clearProgram();
+    }
+    status = PROGRAM_IDLE;
+}
+
+// Empty the program in RAM; the saved copy is kept until saveProgram()
+void clearProgram() {
+    abortProgram();
+    memset(&program, 0, sizeof(program));
+}
+
+bool addProgramStep(const ProgramStep& step) {
+    if (program.length >= PROGRAM_MAX_STEPS || !isStepValid(step, program.length)) {
+        return false;
+    }
+    abortProgram();
+    program.steps[program.length++] = step;
+    return true;
+}
+
+bool saveProgram() {
+    if (status == PROGRAM_STARTING || status == PROGRAM_RUNNING) {
+        return false;
+    }
+    program.checksum = programChecksum();
+    EEPROM.put(EEPROM_PROGRAM_ADDR, program);
+    return true;
+}
+
+// Run the program on the active axis, starting the motor if stopped
+bool startProgram() {
+    MotorAxis& axis = activeAxis();
+
+    if (program.length == 0 || status == PROGRAM_STARTING || status == PROGRAM_RUNNING ||
+        systemParams.syncMode == SYNC_FOLLOWER || axis.state == STATE_ALARM ||
+        axis.state == STATE_STOPPING) {
+        return false;
+    }
+    if (axis.state == STATE_IDLE) {
+        startMotor(axis);
+    }
+    memset(loopDone, 0, sizeof(loopDone));
+    programAxis = selectedAxis;
+    currentStep = 0;
+    lastUpdate = millis();
+    status = PROGRAM_STARTING;
+    return true;
+}
+
+// Hand the setpoint back to the panel: a running motor keeps the program
+// setpoint, a stopping or tripped one restarts from 0 as after menu Stop
+static void releaseSetpoint() {
+    if (status == PROGRAM_RUNNING) {
+        MotorAxis& axis = axes[programAxis];
+        axis.localSetpoint = axis.state == STATE_RUN ? rampSetpoint : 0;
+    }
+}
+
+// End the run, telling the operator why
+static void finishProgram(ProgramStatus result) {
+    releaseSetpoint();
+    status = result;
+    showMessage(result == PROGRAM_DONE ? F("Program done") : F("Program aborted"));
+}
+
+// Leave the motor at its current setpoint
+void abortProgram() {
+    if (status == PROGRAM_STARTING || status == PROGRAM_RUNNING) {
+        releaseSetpoint();
+        status = PROGRAM_ABORTED;
+    }
+}
+
+static void enterStep(uint8_t index, unsigned long currentMillis) {
+    currentStep = index;
+    stepStart = currentMillis;
+}
+
+// Run the current step; true when it is complete
+static bool runStep(MotorAxis& axis, const ProgramStep& step, unsigned long currentMillis, float dt) {
+    unsigned long elapsed = currentMillis - stepStart;
+
+    switch (step.op) {
+        case OP_RAMP: {
+            double target = min((double)step.value, (double)systemParams.speedFullScale);
+            double change = (double)step.arg * PROGRAM_RATE_UNIT * dt;
+            if (step.arg == 0 || fabs(target - rampSetpoint) <= change) {
+                rampSetpoint = target;
+            } else {
+                rampSetpoint += target > rampSetpoint ? change : -change;
+            }
+            return rampSetpoint == target;
+        }
+
+        case OP_HOLD:
+            return elapsed >= step.value * 1000UL;
+
+        case OP_WAIT:
+            if (abs((int32_t)axis.speed - (int32_t)rampSetpoint) <= PROGRAM_AT_SPEED_BAND) {
+                return true;
+            }
+            if (step.value > 0 && elapsed >= step.value * 1000UL) {
+                finishProgram(PROGRAM_ABORTED);
+            }
+            return false;
+
+        case OP_STOP:
+            finishProgram(PROGRAM_DONE);
+            axis.localSetpoint = 0;
+            stopMotor(axis);
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+// Advance the program, called every loop pass
+void updateProgram() {
+    unsigned long currentMillis = millis();
+
+    if ((status != PROGRAM_STARTING && status != PROGRAM_RUNNING) ||
+        currentMillis - lastUpdate < PROGRAM_UPDATE_INTERVAL) {
+        return;
+    }
+    float dt = (currentMillis - lastUpdate) / 1000.0;
+    lastUpdate = currentMillis;
+
+    MotorAxis& axis = axes[programAxis];
+    if (status == PROGRAM_STARTING) {
+        if (axis.state == STATE_RUN) {
+            // The program takes over from the present setpoint
+            status = PROGRAM_RUNNING;
+            rampSetpoint = axis.pidSetpoint;
+            enterStep(0, currentMillis);
+        } else if (axis.state != STATE_STARTING && axis.eventCount == 0) {
+            // The start request has been taken, but the motor is not starting
+            finishProgram(PROGRAM_ABORTED);
+        }
+        return;
+    }
+
+    // Stopped from the panel, or tripped
+    if (axis.state != STATE_RUN) {
+        finishProgram(PROGRAM_ABORTED);
+        return;
+    }
+
+    // Steps that take no time follow each other in the same pass, bounded
+    // so a loop without waiting steps cannot stall the control loop
+    for (uint8_t n = 0; n < PROGRAM_MAX_STEPS && status == PROGRAM_RUNNING; n++) {
+        if (currentStep >= program.length) {
+            finishProgram(PROGRAM_DONE);
+            return;
+        }
+
+        const ProgramStep& step = program.steps[currentStep];
+        if (step.op == OP_LOOP) {
+            if (step.value == 0 || loopDone[currentStep] < step.value) {
+                loopDone[currentStep]++;
+                enterStep(step.arg, currentMillis);
+            } else {
+                loopDone[currentStep] = 0;  // Rearm for an enclosing loop
+                enterStep(currentStep + 1, currentMillis);
+            }
+            continue;
+        }
+
+        if (!runStep(axis, step, currentMillis, dt)) {
+            return;
+        }
+        enterStep(currentStep + 1, currentMillis);
+    }
+}
+
+bool getProgramSetpoint(const MotorAxis& axis, double& setpoint) {
+    if (status != PROGRAM_RUNNING || getAxisIndex(axis) != programAxis) {
+        return false;
+    }
+    setpoint = rampSetpoint;
+    return true;
+}
+
+ProgramStatus getProgramStatus() {
+    return status;
+}
+
+uint8_t getProgramStep() {
+    return currentStep;
+}
+
+uint8_t getProgramStepOp() {
+    return currentStep < program.length ? program.steps[currentStep].op : (uint8_t)OP_END;
+}
+
+uint8_t getProgramLength() {
+    return program.length;
+}
+
+uint16_t getProgramRemaining() {
+    if (status != PROGRAM_RUNNING || currentStep >= program.length) {
+        return 0;
+    }
+
+    const ProgramStep& step = program.steps[currentStep];
+    unsigned long elapsed = (millis() - stepStart) / 1000;
+
+    if ((step.op != OP_HOLD && step.op != OP_WAIT) || elapsed >= step.value) {
+        return 0;
+    }
+    return step.value - elapsed;
+}
+
+const __FlashStringHelper* getProgramOpText(uint8_t op) {
+    switch (op) {
+        case OP_RAMP: return F("RAMP");
+        case OP_HOLD: return F("HOLD");
+        case OP_WAIT: return F("WAIT");
+        case OP_LOOP: return F("LOOP");
+        case OP_STOP: return F("STOP");
+        default:      return F("END");
+    }
+}
+
+const __FlashStringHelper* getProgramStatusText() {
+    switch (status) {
+        case PROGRAM_STARTING: return F("START");
+        case PROGRAM_RUNNING:  return F("RUN");
+        case PROGRAM_DONE:     return F("DONE");
+        case PROGRAM_ABORTED:  return F("ABORT");
+        default:               return F("IDLE");
+    }
+}
+
+// List the steps as CSV and the runner status
+void printProgram(Print& out) {
+    out.println(F("# step,op,value,arg"));
+    for (uint8_t i = 0; i < program.length; i++) {
+        const ProgramStep& step = program.steps[i];
+        out.print(i);
+        out.print(',');
+        out.print(getProgramOpText(step.op));
+        out.print(',');
+        out.print(step.value);
+        out.print(',');
+        out.println(step.op == OP_RAMP ? step.arg * PROGRAM_RATE_UNIT : step.arg);
+    }
+    out.print(F("status="));
+    out.println(getProgramStatusText());
+    out.print(F("step="));
+    out.println(currentStep);
+}
@@ -0,0 +1,77 @@
+/*
+ * Speed program declarations for DC Motor Speed Control Project
+ *
+ * A speed program is a short list of fixed-size steps kept in EEPROM and
+ * run on the active axis:
+ *   RAMP rpm rate   - move the setpoint to rpm at rate RPM/s (0 = at once)
+ *   HOLD s          - keep the setpoint for s seconds
+ *   WAIT s          - wait until the speed is within PROGRAM_AT_SPEED_BAND
+ *                     of the setpoint; abort after s seconds (0 = no limit)
+ *   LOOP step n     - jump back to step, n times (0 = forever)
+ *   STOP            - stop the motor and end the program
+ * The runner is a small state machine advanced by updateProgram() every
+ * control step, with all state in static storage. Programs are entered
+ * over Serial (see serial_commands.cpp) and saved with a checksum.
+ * A running program is the setpoint source of its axis (see setpoint.h);
+ * when it ends the axis keeps the last program setpoint as local setpoint.
+ */
+
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For Print
+#include "config.h"
+
+// Step operations
+enum ProgramOp {
+    OP_END,
+    OP_RAMP,     // value = RPM, arg = rate in PROGRAM_RATE_UNIT RPM/s
+    OP_HOLD,     // value = seconds
+    OP_WAIT,     // value = timeout in seconds
+    OP_LOOP,     // arg = target step, value = repeat count
+    OP_STOP
+};
+
+// Program step as stored in EEPROM (4 bytes)
+struct ProgramStep {
+    uint8_t op;         // ProgramOp
+    uint8_t arg;
+    uint16_t value;
+};
+
+// Runner states
+enum ProgramStatus {
+    PROGRAM_IDLE,
+    PROGRAM_STARTING,   // Waiting for the soft start
+    PROGRAM_RUNNING,
+    PROGRAM_DONE,
+    PROGRAM_ABORTED     // Motor stopped, alarm or wait timeout
+};
+
+const uint8_t PROGRAM_MAX_STEPS = 12;            // 2 + 12 * 4 bytes from EEPROM_PROGRAM_ADDR
+const uint8_t PROGRAM_RATE_UNIT = 10;            // RPM/s per unit of a ramp rate
+const uint16_t PROGRAM_AT_SPEED_BAND = 20;       // RPM
+const unsigned long PROGRAM_UPDATE_INTERVAL = 10;  // ms
+
+struct MotorAxis;  // See axis.h
+
+// Function declarations
+void initializeProgram();
+void clearProgram();
+bool addProgramStep(const ProgramStep& step);
+bool saveProgram();
+bool startProgram();
+void abortProgram();
+void updateProgram();
+bool getProgramSetpoint(const MotorAxis& axis, double& setpoint);  // False unless running on axis
+ProgramStatus getProgramStatus();
+uint8_t getProgramStep();
+uint8_t getProgramStepOp();
+uint8_t getProgramLength();
+uint16_t getProgramRemaining();  // Seconds left in a HOLD or WAIT step
+const __FlashStringHelper* getProgramOpText(uint8_t op);
+const __FlashStringHelper* getProgramStatusText();
+void printProgram(Print& out);
+
+#endif
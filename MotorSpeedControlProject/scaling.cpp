@@ -0,0 +1,40 @@
+/*
+ * Input scaling implementation for DC Motor Speed Control Project
+ */
+
+#include "scaling.h"
+#include <math.h>
+#include "globals.h"
+#include "pins.h"  // For LED_BAR_COUNT
+#include "fast_trip.h"  // For FAST_TRIP_VREF_MV
+#include "led_bar.h"    // For LED_BAR_ERROR_RANGE_PERCENT
+
+InputScaling inputScaling;
+
+// Function to recompute the scaling constants from systemParams
+void updateScaling() {
+    const float maxCount = ADC_RESOLUTION - 1;
+    const float one = 1UL << SCALING_SHIFT;
+
+    inputScaling.rpmPerCount = (uint32_t)(systemParams.speedFullScale * one / maxCount + 0.5f);
+    inputScaling.currentFullScaleMilliAmps = (uint16_t)(systemParams.currentFullScale * 1000.0f + 0.5f);
+    inputScaling.milliAmpsPerCount =
+        (uint32_t)(inputScaling.currentFullScaleMilliAmps * one / maxCount + 0.5f);
+    inputScaling.ledsPerRpm = (uint32_t)ceil(LED_BAR_COUNT * one / systemParams.speedFullScale);
+    inputScaling.ledsPerMilliAmp =
+        (uint32_t)ceil(LED_BAR_COUNT * one / inputScaling.currentFullScaleMilliAmps);
+    // Error mode: half the bar either side of the centre LED
+    inputScaling.ledsPerErrorRpm = (uint32_t)ceil((LED_BAR_COUNT / 2) * one * 100 /
+        (systemParams.speedFullScale * (float)LED_BAR_ERROR_RANGE_PERCENT));
+
+    // Thresholds are fractions of full scale, i.e. fixed ADC counts
+    inputScaling.overcurrentRaw = (uint16_t)ceil(OVERCURRENT_THRESHOLD * maxCount);
+    inputScaling.softStartLimitRaw = (uint16_t)ceil(SOFT_START_CURRENT_LIMIT * maxCount);
+    // Same threshold in steps of the comparator DAC: ADC counts are of VDD,
+    // DAC steps of FAST_TRIP_VREF_MV / 256
+    uint32_t dacRef = ((uint32_t)inputScaling.overcurrentRaw * ADC_REFERENCE_MV * 256 +
+                       FAST_TRIP_VREF_MV * (uint32_t)ADC_RESOLUTION / 2) /
+                      (FAST_TRIP_VREF_MV * (uint32_t)ADC_RESOLUTION);
+    inputScaling.overcurrentDacRef = dacRef > 255 ? 255 : dacRef;
+    inputScaling.overspeedRpm = (uint16_t)(systemParams.speedFullScale * OVERSPEED_THRESHOLD);
+}
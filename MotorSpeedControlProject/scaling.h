@@ -0,0 +1,47 @@
+/*
+ * Input scaling declarations for DC Motor Speed Control Project
+ *
+ * ADC counts are converted to engineering units with integer multipliers
+ * and compared against raw count thresholds. The constants depend on the
+ * full scale parameters and are recomputed by updateScaling() whenever
+ * systemParams change, so the control loop does no float math on inputs.
+ */
+
+#ifndef SCALING_H
+#define SCALING_H
+
+#include <stdint.h>
+#include "config.h"
+
+const uint8_t SCALING_SHIFT = 16;  // Fractional bits of the multipliers
+
+// Precomputed scaling constants
+struct InputScaling {
+    uint32_t rpmPerCount;          // Speed multiplier, Q16
+    uint32_t milliAmpsPerCount;    // Current multiplier, Q16
+    uint32_t ledsPerRpm;           // LED bar multiplier, Q16
+    uint32_t ledsPerMilliAmp;      // LED bar multiplier in current mode, Q16
+    uint32_t ledsPerErrorRpm;      // LED bar multiplier in error mode, Q16
+    uint16_t currentFullScaleMilliAmps;
+    uint16_t overcurrentRaw;       // Overcurrent threshold in ADC counts
+    uint8_t overcurrentDacRef;     // Overcurrent threshold for the AC0 DAC reference
+    uint16_t softStartLimitRaw;    // Soft start current limit in ADC counts
+    uint16_t overspeedRpm;         // Overspeed alarm threshold
+};
+
+extern InputScaling inputScaling;
+
+// Function declarations
+void updateScaling();
+
+// Function to convert a raw speed reading to RPM
+inline uint16_t scaleSpeed(uint16_t raw) {
+    return (raw * inputScaling.rpmPerCount + (1UL << (SCALING_SHIFT - 1))) >> SCALING_SHIFT;
+}
+
+// Function to convert a raw current reading to mA
+inline uint16_t scaleCurrent(uint16_t raw) {
+    return (raw * inputScaling.milliAmpsPerCount + (1UL << (SCALING_SHIFT - 1))) >> SCALING_SHIFT;
+}
+
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Serial command interface implementation for DC Motor Speed Control Project
+ *
+ * Commands are plain text lines terminated by CR or LF:
+ *   LOG        - dump the event log
+ *   LOG CLEAR  - erase the event log
+ *   STATS      - print operating counters and loop timing
+ *   PERF       - print response metrics and control core cycle counts
+ *   PERF RESET - clear cycle counts and restart the response window
+ *   STEP n     - set the active axis local setpoint to n RPM while running
+ *   SET n      - set the serial setpoint to n RPM (see setpoint.h)
+ *   BENCH      - run the microbenchmarks, motors stopped
+ *   DIAG       - print RAM headroom and the reset cause
+ *   IDENT      - print the identified plant model and suggested gains
+ *   IDENT SAVE - store the active axis model as the drift baseline
+ *   IDENT APPLY - take over the suggested gains of the active axis
+ *   PROG       - list the speed program and its status
+ *   PROG RAMP rpm [rate] / HOLD s / WAIT [s] / LOOP step [n] / STOP
+ *              - append a step (see program.h)
+ *   PROG CLEAR / SAVE / RUN / ABORT - edit, store and run the program
+ *
+ * Replies are written to a RAM buffer and sent from loop() as the UART
+ * transmit buffer drains, so a report never holds up the control loop.
+ * Output past the end of the buffer is dropped and the reply marked as
+ * truncated. The next command is read once the previous reply has been sent.
+ */
+
+#include "serial_commands.h"
+#include <Arduino.h>
+#include <ctype.h>
+#include "event_log.h"
+#include "counters.h"
+#include "watchdog.h"  // For printLoopStats()
+#include "perf.h"
+#include "bench.h"
+#include "diagnostics.h"
+#include "pid.h"       // For setSpeedSetpoint()
+#include "axis.h"      // For activeAxis()
+#include "plant_id.h"
+#include "program.h"
+#include "setpoint.h"
+
+static char commandBuffer[SERIAL_COMMAND_MAX_LENGTH + 1];
+static uint8_t commandLength = 0;
+
+// Reply ring buffer, drained by sendReply()
+static uint8_t replyBuffer[SERIAL_REPLY_BUFFER_SIZE];
+static uint16_t replyHead = 0;
+static uint16_t replyCount = 0;
+static bool replyTruncated = false;
+
+// Last line of a reply that did not fit, after the end of the cut line;
+// room for both is always kept
+static const char REPLY_TRUNCATED[] PROGMEM = "\r\n# truncated\r\n";
+const uint8_t REPLY_TRUNCATED_LENGTH = sizeof(REPLY_TRUNCATED) - 1;
+
+static void queueReply(uint8_t c) {
+    replyBuffer[(replyHead + replyCount) % SERIAL_REPLY_BUFFER_SIZE] = c;
+    replyCount++;
+}
+
+// Send buffered reply bytes while the UART has room, never waiting
+static void sendReply() {
+    int room = Serial.availableForWrite();
+
+    while (room-- > 0 && replyCount > 0) {
+        Serial.write(replyBuffer[replyHead]);
+        replyHead = (replyHead + 1) % SERIAL_REPLY_BUFFER_SIZE;
+        replyCount--;
+    }
+}
+
+// Print target of the command replies
+class ReplyPrint : public Print {
+public:
+    using Print::write;
+
+    size_t write(uint8_t c) {
+        // A reply is built in one pass, so a full buffer never drains in time
+        if (replyCount >= SERIAL_REPLY_BUFFER_SIZE - REPLY_TRUNCATED_LENGTH) {
+            replyTruncated = true;
+            return 0;
+        }
+        queueReply(c);
+        return 1;
+    }
+};
+
+static ReplyPrint reply;
+
+// End a reply, marking it if output was dropped
+static void finishReply() {
+    if (replyTruncated) {
+        // Skip the line end when the cut fell between lines
+        uint16_t last = (replyHead + replyCount + SERIAL_REPLY_BUFFER_SIZE - 1) % SERIAL_REPLY_BUFFER_SIZE;
+        uint8_t first = replyCount > 0 && replyBuffer[last] == '\n' ? 2 : 0;
+        for (uint8_t i = first; i < REPLY_TRUNCATED_LENGTH; i++) {
+            queueReply(pgm_read_byte(&REPLY_TRUNCATED[i]));
+        }
+        replyTruncated = false;
+    }
+}
+
+// Parse "OP n [m]" into a program step; missing numbers are 0
+static bool parseProgramStep(const char* text, ProgramStep& step) {
+    static const char OP_NAMES[] PROGMEM = "RAMP HOLD WAIT LOOP STOP ";
+    char* end;
+
+    memset(&step, 0, sizeof(step));
+    for (uint8_t op = OP_RAMP; op <= OP_STOP; op++) {
+        if (strncmp_P(text, OP_NAMES + (op - OP_RAMP) * 5, 4) == 0 &&
+            (text[4] == ' ' || text[4] == '\0')) {
+            step.op = op;
+        }
+    }
+    if (step.op == OP_END) {
+        return false;
+    }
+
+    unsigned long first = strtoul(text + 4, &end, 10);
+    unsigned long second = strtoul(end, &end, 10);
+    switch (step.op) {
+        case OP_RAMP:
+            // Rate in RPM/s, rounded up to the stored unit
+            second = (second + PROGRAM_RATE_UNIT - 1) / PROGRAM_RATE_UNIT;
+            step.value = first;
+            step.arg = second > 255 ? 255 : second;
+            break;
+        case OP_LOOP:
+            step.arg = first;
+            step.value = second;
+            break;
+        default:
+            step.value = first;
+            break;
+    }
+    return first <= UINT16_MAX && second <= UINT16_MAX;
+}
+
+static void executeProgramCommand(const char* args) {
+    ProgramStep step;
+
+    if (*args == '\0') {
+        printProgram(reply);
+    } else if (strcmp(args, " CLEAR") == 0) {
+        clearProgram();
+        reply.println(F("OK"));
+    } else if (strcmp(args, " SAVE") == 0) {
+        reply.println(saveProgram() ? F("OK") : F("ERR running"));
+    } else if (strcmp(args, " RUN") == 0) {
+        reply.println(startProgram() ? F("OK") : F("ERR cannot start"));
+    } else if (strcmp(args, " ABORT") == 0) {
+        abortProgram();
+        reply.println(F("OK"));
+    } else if (*args == ' ' && parseProgramStep(args + 1, step)) {
+        reply.println(addProgramStep(step) ? F("OK") : F("ERR invalid step"));
+    } else {
+        reply.println(F("ERR unknown command"));
+    }
+}
+
+// Execute a complete command line
+static void executeCommand(const char* command) {
+    if (strcmp(command, "LOG") == 0) {
+        dumpEventLog(reply);
+    } else if (strcmp(command, "LOG CLEAR") == 0) {
+        clearEventLog();
+        reply.println(F("OK"));
+    } else if (strcmp(command, "STATS") == 0) {
+        printCounters(reply);
+        printLoopStats(reply);
+    } else if (strcmp(command, "PERF") == 0) {
+        printPerf(reply);
+    } else if (strcmp(command, "PERF RESET") == 0) {
+        resetPerf();
+        reply.println(F("OK"));
+    } else if (strncmp(command, "STEP ", 5) == 0) {
+        if (!isMotorRunning(activeAxis())) {
+            reply.println(F("ERR not running"));
+        } else if (getSetpointSource(activeAxis()) != SOURCE_LOCAL) {
+            reply.println(F("ERR source"));
+        } else {
+            setSpeedSetpoint(activeAxis(), atoi(command + 5));
+            reply.println(F("OK"));
+        }
+    } else if (strncmp(command, "SET ", 4) == 0) {
+        long rpm = atol(command + 4);
+        setSerialSetpoint(rpm < 0 ? 0 : (rpm > UINT16_MAX ? UINT16_MAX : rpm));
+        reply.println(F("OK"));
+    } else if (strcmp(command, "DIAG") == 0) {
+        printDiagnostics(reply);
+    } else if (strcmp(command, "IDENT") == 0) {
+        printPlantId(reply);
+    } else if (strcmp(command, "IDENT SAVE") == 0) {
+        reply.println(savePlantBaseline(activeAxis()) ? F("OK") : F("ERR no model"));
+    } else if (strcmp(command, "IDENT APPLY") == 0) {
+        reply.println(applySuggestedGains(activeAxis()) ? F("OK") : F("ERR no model"));
+    } else if (strncmp(command, "PROG", 4) == 0) {
+        executeProgramCommand(command + 4);
+    } else if (strcmp(command, "BENCH") == 0) {
+        if (!runBenchmarks(reply)) {
+            reply.println(F("ERR motor running"));
+        }
+    } else if (command[0] != '\0') {
+        reply.println(F("ERR unknown command"));
+    }
+}
+
+// Send the pending reply, then collect characters without blocking and
+// run complete lines
+void processSerialCommands() {
+    sendReply();
+
+    while (replyCount == 0 && Serial.available() > 0) {
+        char c = Serial.read();
+
+        if (c == '\r' || c == '\n') {
+            commandBuffer[commandLength] = '\0';
+            executeCommand(commandBuffer);
+            finishReply();
+            commandLength = 0;
+        } else if (commandLength < SERIAL_COMMAND_MAX_LENGTH) {
+            commandBuffer[commandLength++] = toupper(c);
+        }
+    }
+}
@@ -0,0 +1,26 @@
+/*
+ * Serial command interface declarations for DC Motor Speed Control Project
+ */
+
+#ifndef SERIAL_COMMANDS_H
+#define SERIAL_COMMANDS_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Longest accepted command line
+const uint8_t SERIAL_COMMAND_MAX_LENGTH = 32;
+
+// Reply buffer, sized for the longest report plus the 15 bytes kept for
+// the truncation mark: PERF is at most 424 bytes with every value at its
+// widest, a full LOG about 400. A longer reply is cut short and ends with
+// a "# truncated" line.
+const uint16_t SERIAL_REPLY_BUFFER_SIZE = 440;
+
+// USB serial port speed
+const unsigned long SERIAL_BAUD_RATE = 115200;
+
+// Function declarations
+void processSerialCommands();
+
+#endif
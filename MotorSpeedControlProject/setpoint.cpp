@@ -0,0 +1,227 @@
+/*
+ * Setpoint source implementation for DC Motor Speed Control Project
+ */
+
+#include "setpoint.h"
+#include "globals.h"
+#include "pins.h"
+#include "axis.h"
+#include "states.h"      // For isMotorRunning()
+#include "filters.h"
+#include "program.h"     // For getProgramSetpoint()
+#include "speed_sync.h"  // For getSyncSetpoint()
+
+// Serial source
+static uint16_t serialSetpoint = 0;
+
+// Frequency source: pulses counted by the pin interrupt
+static volatile uint16_t pulseCount = 0;
+static volatile unsigned long pulseTime = 0;   // micros() of the last pulse
+static bool pulsesAttached = false;
+static bool edgeValid = false;                 // edgeTime holds a pulse
+static unsigned long edgeTime = 0;             // Last pulse of the previous window
+static float frequency = 0;                    // Hz
+
+// Analog source: a conversion runs from one loop pass to the next
+static FilterChannel analogFilter;
+static uint16_t analogSetpoint = 0;            // Filtered, 0-4092 counts
+#if EXTERNAL_SETPOINT_INPUT
+static bool analogPending = false;             // Conversion started, ADC set up for it
+static uint8_t analogCtrlb = 0;                // ADC setup of analogRead(), restored
+static uint8_t analogMuxpos = 0;               // once the conversion is collected
+static unsigned long analogSampleTime = 0;
+#endif
+
+static void onSetpointPulse() {
+    pulseCount++;
+    pulseTime = micros();
+}
+
+void initializeSetpoints() {
+    initializeFilter(analogFilter, FILTER_MEDIAN3);
+#if EXTERNAL_SETPOINT_INPUT
+    pinMode(SETPOINT_ANALOG_PIN, INPUT);
+#endif
+}
+
+// Count pulses only while the frequency source is selected, and never on
+// the sync link traffic of a follower
+static void attachPulseInput() {
+    bool wanted = systemParams.setpointSource == SOURCE_FREQUENCY &&
+                  systemParams.syncMode != SYNC_FOLLOWER;
+
+    if (wanted == pulsesAttached) {
+        return;
+    }
+    if (wanted) {
+        pinMode(SETPOINT_FREQUENCY_PIN, INPUT);
+        attachInterrupt(digitalPinToInterrupt(SETPOINT_FREQUENCY_PIN), onSetpointPulse, RISING);
+    } else {
+        detachInterrupt(digitalPinToInterrupt(SETPOINT_FREQUENCY_PIN));
+    }
+    pulsesAttached = wanted;
+    edgeValid = false;
+    frequency = 0;
+}
+
+// Pulse frequency from the pulses of the last window, measured between the
+// last pulses of successive windows so it holds no count quantization
+static float measureFrequency() {
+    unsigned long currentMicros = micros();
+
+    noInterrupts();
+    uint16_t count = pulseCount;
+    unsigned long time = pulseTime;
+    interrupts();
+
+    if (count == 0) {
+        if (!edgeValid || currentMicros - edgeTime > SETPOINT_FREQUENCY_TIMEOUT * 1000UL) {
+            edgeValid = false;
+            frequency = 0;
+        }
+        return frequency;
+    }
+    if (edgeValid && time - edgeTime < SETPOINT_FREQUENCY_WINDOW) {
+        return frequency;
+    }
+
+    noInterrupts();
+    count = pulseCount;
+    time = pulseTime;
+    pulseCount = 0;
+    interrupts();
+
+    if (edgeValid) {
+        frequency = count * 1000000.0 / (time - edgeTime);
+    }
+    edgeTime = time;
+    edgeValid = true;
+    return frequency;
+}
+
+// Start four conversions of the analog setpoint, accumulated by the ADC.
+// analogRead() cannot select D12, so the input is converted directly. Called
+// once the inputs of the pass are read, so the conversion runs alongside
+// the rest of the pass and is done before readInputs() needs the ADC again.
+void startSetpointConversion() {
+#if EXTERNAL_SETPOINT_INPUT
+    if (analogPending || systemParams.setpointSource != SOURCE_ANALOG) {
+        return;
+    }
+    analogCtrlb = ADC0.CTRLB;
+    analogMuxpos = ADC0.MUXPOS;
+    ADC0.CTRLB = ADC_SAMPNUM_ACC4_gc;
+    ADC0.MUXPOS = ADC_MUXPOS_AIN9_gc;
+    ADC0.COMMAND = ADC_STCONV_bm;
+    analogPending = true;
+#endif
+}
+
+// Take the conversion started on the previous pass and hand the ADC back
+// to analogRead()
+static void collectAnalogSetpoint() {
+#if EXTERNAL_SETPOINT_INPUT
+    if (!analogPending) {
+        return;
+    }
+    // Only a pass shorter than the conversion (about 100 us) waits here
+    while (!(ADC0.INTFLAGS & ADC_RESRDY_bm) && (ADC0.COMMAND & ADC_STCONV_bm)) {
+    }
+    // No result if an analogRead() in between (BENCH) took it
+    if (ADC0.INTFLAGS & ADC_RESRDY_bm) {
+        uint16_t sum = ADC0.RES;  // Reading RES clears RESRDY
+        unsigned long currentMicros = micros();
+        analogSetpoint = applyFilter(analogFilter, sum, SETPOINT_ANALOG_FILTER,
+                                     currentMicros - analogSampleTime);
+        analogSampleTime = currentMicros;
+    }
+    ADC0.CTRLB = analogCtrlb;
+    ADC0.MUXPOS = analogMuxpos;
+    analogPending = false;
+#endif
+}
+
+// Target of the selected source in RPM
+static int32_t readSelectedSource() {
+    switch (systemParams.setpointSource) {
+        case SOURCE_SERIAL:
+            return serialSetpoint;
+
+        case SOURCE_FREQUENCY:
+            return measureFrequency() * systemParams.speedFullScale / SETPOINT_FREQUENCY_FULL_SCALE;
+
+        case SOURCE_ANALOG:
+            return (int32_t)analogSetpoint * systemParams.speedFullScale /
+                   (4 * (ADC_RESOLUTION - 1));
+
+        default:
+            return -1;  // Per axis local setpoint
+    }
+}
+
+// Copy the active source to the PID setpoint of every axis, called every
+// loop pass ahead of the control core
+void updateSetpoints() {
+    static unsigned long lastUpdate = 0;
+    unsigned long currentMicros = micros();
+    float dt = (currentMicros - lastUpdate) * 1e-6;
+    lastUpdate = currentMicros;
+
+    attachPulseInput();
+    collectAnalogSetpoint();
+    int32_t selected = readSelectedSource();
+
+    for (uint8_t i = 0; i < AXIS_COUNT; i++) {
+        MotorAxis& axis = axes[i];
+        SetpointSource source = (SetpointSource)systemParams.setpointSource;
+        double target = selected >= 0 ? selected : axis.localSetpoint;
+
+        if (systemParams.syncMode == SYNC_FOLLOWER) {
+            source = SOURCE_SYNC;
+            target = getSyncSetpoint();
+        }
+        if (getProgramSetpoint(axis, target)) {
+            source = SOURCE_PROGRAM;
+        }
+        target = constrain(target, 0.0, (double)systemParams.speedFullScale);
+
+        // A new source is approached at the switch rate while running; the
+        // program starts from the present setpoint by itself
+        if (source != axis.setpointSource) {
+            axis.setpointSource = source;
+            axis.setpointSwitching = source != SOURCE_PROGRAM;
+        }
+        if (!isMotorRunning(axis)) {
+            axis.setpointSwitching = false;
+        }
+
+        if (axis.setpointSwitching) {
+            double change = SETPOINT_SWITCH_RATE * dt;
+            if (fabs(target - axis.pidSetpoint) <= change) {
+                axis.setpointSwitching = false;
+            } else {
+                target = axis.pidSetpoint + (target > axis.pidSetpoint ? change : -change);
+            }
+        }
+        axis.pidSetpoint = target;
+    }
+}
+
+void setSerialSetpoint(uint16_t rpm) {
+    serialSetpoint = rpm;
+}
+
+SetpointSource getSetpointSource(const MotorAxis& axis) {
+    return (SetpointSource)axis.setpointSource;
+}
+
+const __FlashStringHelper* getSetpointSourceText(SetpointSource source) {
+    switch (source) {
+        case SOURCE_SERIAL:    return F("Serial");
+        case SOURCE_FREQUENCY: return F("Freq");
+        case SOURCE_ANALOG:    return F("Analog");
+        case SOURCE_PROGRAM:   return F("Prog");
+        case SOURCE_SYNC:      return F("Sync");
+        default:               return F("Local");
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Setpoint source declarations for DC Motor Speed Control Project
+ *
+ * Every axis takes its speed setpoint from one source. The source selected
+ * in Settings > Source is one of:
+ *   Local     - UP/DOWN on the main screen, or the STEP command
+ *   Serial    - the SET command
+ *   Freq      - pulse frequency on D0, SETPOINT_FREQUENCY_FULL_SCALE Hz
+ *               = speed full scale (not while following the sync link)
+ *   Analog    - 0-5 V on D12, hardware accumulated and filtered; built with
+ *               EXTERNAL_SETPOINT_INPUT (config.h)
+ * A running speed program, and the sync link in follower mode, take over
+ * from the selected source.
+ *
+ * updateSetpoints() copies the active source to the PID setpoint on every
+ * loop pass, so an external source reaches the controller within one pass.
+ * The analog input is converted while the rest of the previous pass runs
+ * (startSetpointConversion()), so reading it never waits on the ADC.
+ * When the active source of a running axis changes, the setpoint moves to
+ * the new value at SETPOINT_SWITCH_RATE instead of stepping.
+ */
+
+#ifndef SETPOINT_H
+#define SETPOINT_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For __FlashStringHelper
+#include "config.h"
+
+struct MotorAxis;  // See axis.h
+
+// Setpoint sources; the first ones are selectable, the last take over
+enum SetpointSource {
+    SOURCE_LOCAL,
+    SOURCE_SERIAL,
+    SOURCE_FREQUENCY,
+    SOURCE_ANALOG,
+    SOURCE_PROGRAM,    // Speed program running on the axis
+    SOURCE_SYNC        // Sync link follower
+};
+
+// Last selectable source
+const uint8_t SETPOINT_SOURCE_MAX = EXTERNAL_SETPOINT_INPUT ? SOURCE_ANALOG : SOURCE_FREQUENCY;
+
+const float SETPOINT_SWITCH_RATE = 500.0;                // RPM/s after a source change
+const uint16_t SETPOINT_FREQUENCY_FULL_SCALE = 1000;     // Hz at speed full scale
+const unsigned long SETPOINT_FREQUENCY_WINDOW = 20000;   // Shortest measurement window in us
+const unsigned long SETPOINT_FREQUENCY_TIMEOUT = 200;    // No pulse for this long reads 0 Hz, in ms
+const uint8_t SETPOINT_ANALOG_FILTER = 3;                // IIR time constant of the analog input (8 ms)
+
+// Function declarations
+void initializeSetpoints();
+void updateSetpoints();
+void startSetpointConversion();
+void setSerialSetpoint(uint16_t rpm);
+SetpointSource getSetpointSource(const MotorAxis& axis);
+const __FlashStringHelper* getSetpointSourceText(SetpointSource source);
+
+#endif
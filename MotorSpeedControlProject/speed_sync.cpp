@@ -0,0 +1,132 @@
+/*
+ * Speed synchronization implementation for DC Motor Speed Control Project
+ */
+
+#include "speed_sync.h"
+#include <Arduino.h>
+#include "globals.h"
+
+// Follower receive state
+static SyncFrame rxFrame;
+static uint8_t rxLength = 0;           // Bytes of rxFrame received
+static bool referenceValid = false;    // At least one frame received
+static unsigned long referenceTime = 0;  // Arrival of the last frame
+static uint16_t referenceSpeed = 0;
+static int16_t referenceSlope = 0;
+static uint8_t lastSequence = 0;
+static uint16_t lostFrames = 0;
+static int32_t followerSetpoint = 0;
+
+static uint8_t frameChecksum(const SyncFrame& frame) {
+    const uint8_t* bytes = (const uint8_t*)&frame;
+    uint8_t sum = 0x5A;
+    for (uint8_t i = 0; i < sizeof(SyncFrame) - 1; i++) {
+        sum += bytes[i];
+    }
+    return sum;
+}
+
+void initializeSync() {
+    Serial1.begin(SYNC_BAUD_RATE);
+}
+
+// Broadcast the speed of the first axis with its slope over the last period
+static void broadcastReference() {
+    static unsigned long lastBroadcast = 0;
+    static uint16_t lastSpeed = 0;
+    static uint8_t sequence = 0;
+    unsigned long currentMillis = millis();
+
+    if (currentMillis - lastBroadcast < SYNC_BROADCAST_INTERVAL) {
+        return;
+    }
+
+    SyncFrame frame;
+    frame.start = SYNC_FRAME_START;
+    frame.sequence = sequence++;
+    frame.speed = axes[0].speed;
+    // Saturated: a change of over 655 RPM in one period would wrap the int16
+    int32_t slope = ((int32_t)frame.speed - lastSpeed) * 1000 / (long)(currentMillis - lastBroadcast);
+    frame.slope = constrain(slope, (int32_t)INT16_MIN, (int32_t)INT16_MAX);
+    frame.checksum = frameChecksum(frame);
+
+    // The frame fits in the transmit buffer, so this never blocks
+    if (Serial1.availableForWrite() >= (int)sizeof(SyncFrame)) {
+        Serial1.write((const uint8_t*)&frame, sizeof(SyncFrame));
+    }
+
+    lastSpeed = frame.speed;
+    lastBroadcast = currentMillis;
+}
+
+// Collect frame bytes without blocking, resynchronizing on the start byte
+static void receiveReference() {
+    while (Serial1.available() > 0) {
+        uint8_t c = Serial1.read();
+
+        if (rxLength == 0 && c != SYNC_FRAME_START) {
+            continue;
+        }
+        ((uint8_t*)&rxFrame)[rxLength++] = c;
+        if (rxLength < sizeof(SyncFrame)) {
+            continue;
+        }
+        rxLength = 0;
+
+        if (rxFrame.checksum != frameChecksum(rxFrame)) {
+            continue;
+        }
+        if (referenceValid && rxFrame.sequence != (uint8_t)(lastSequence + 1)) {
+            lostFrames++;
+        }
+        lastSequence = rxFrame.sequence;
+        referenceSpeed = rxFrame.speed;
+        referenceSlope = rxFrame.slope;
+        referenceTime = millis();
+        referenceValid = true;
+    }
+}
+
+// Run the sync role, called every loop pass
+void updateSync() {
+    switch(systemParams.syncMode) {
+        case SYNC_MASTER:
+            broadcastReference();
+            break;
+
+        case SYNC_FOLLOWER:
+            receiveReference();
+            if (!isReferenceLost()) {
+                followerSetpoint = (int32_t)(getSyncReference() * systemParams.syncRatio)
+                                   + systemParams.syncTrim;
+            }
+            break;
+
+        default:
+            referenceValid = false;
+            break;
+    }
+}
+
+bool isReferenceLost() {
+    return systemParams.syncMode == SYNC_FOLLOWER &&
+           (!referenceValid || millis() - referenceTime > SYNC_TIMEOUT);
+}
+
+// Reference extrapolated over the frame age and link latency
+uint16_t getSyncReference() {
+    if (!referenceValid) {
+        return 0;
+    }
+    long age = millis() - referenceTime + SYNC_LINK_LATENCY;
+    long speed = referenceSpeed + (long)referenceSlope * age / 1000;
+    return speed > 0 ? speed : 0;
+}
+
+uint16_t getSyncLostFrames() {
+    return lostFrames;
+}
+
+int32_t getSyncSetpoint() {
+    return followerSetpoint;
+}
@@ -0,0 +1,45 @@
+/*
+ * Speed synchronization declarations for DC Motor Speed Control Project
+ *
+ * A master drive broadcasts its speed reference on the sync link (Serial1,
+ * D0/D1); follower drives set their setpoint to reference * ratio + trim.
+ * Frames carry the speed slope, so a follower can extrapolate over the
+ * frame age and link latency. A follower running without a fresh frame
+ * raises ALARM_REFERENCE_LOSS.
+ */
+
+#ifndef SPEED_SYNC_H
+#define SPEED_SYNC_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Sync link configuration
+const unsigned long SYNC_BAUD_RATE = 115200;
+const unsigned long SYNC_BROADCAST_INTERVAL = 20;  // Master frame period in ms
+const unsigned long SYNC_TIMEOUT = 200;            // Reference lost after this silence in ms
+const unsigned long SYNC_LINK_LATENCY = 2;         // Master sampling and transmission delay in ms
+const int SYNC_TRIM_LIMIT = 500;                   // Trim range in RPM
+const uint8_t SYNC_FRAME_START = 0xA5;
+
+// Reference frame as sent on the link (7 bytes, packed so that builds for
+// other targets, such as the host tests, use the same layout)
+struct __attribute__((packed)) SyncFrame {
+    uint8_t start;       // SYNC_FRAME_START
+    uint8_t sequence;    // Incremented on every frame
+    uint16_t speed;      // Master speed in RPM
+    int16_t slope;       // Master speed change in RPM/s
+    uint8_t checksum;    // Sum of the bytes before it
+};
+
+static_assert(sizeof(SyncFrame) == 7, "SyncFrame is the 7 byte link format");
+
+// Function declarations
+void initializeSync();
+void updateSync();
+bool isReferenceLost();
+uint16_t getSyncReference();    // Latency compensated reference in RPM
+uint16_t getSyncLostFrames();   // Sequence gaps seen by a follower
+int32_t getSyncSetpoint();      // Follower setpoint, held while the reference is lost
+
+#endif
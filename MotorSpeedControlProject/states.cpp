@@ -4,104 +4,227 @@
 
 #include "states.h"
 #include "globals.h"
-#include "Mapf.h"
+#include "scaling.h"
+#include "event_log.h"
+#include "pid.h"
+#include "axis.h"
+#include "alarms.h"  // For raiseAlarm()
+#include "fast_trip.h"
 
-// Current measurements
-float currentSpeed = 0.0;
-float currentCurrent = 0.0;
-bool isOvercurrent = false;
-SystemState previousState = STATE_UNDEFINED;
+// Read analog inputs and convert to actual values
+void readInputs(MotorAxis& axis) {
+    // Sample interval, for filter time constants in ms
+    unsigned long currentMicros = micros();
+    unsigned long dt = currentMicros - axis.lastInputTime;
+    axis.lastInputTime = currentMicros;
+
+    // Read speed input
+    uint16_t speedRaw = analogRead(axis.pins->speedSense);
+    axis.speed = scaleSpeed(applyFilter(axis.speedFilter, speedRaw, systemParams.speedFilter, dt));
+    
+    // Read current input; the limits below act on the unfiltered sample
+    axis.currentRaw = analogRead(axis.pins->currentSense);
+    axis.milliAmps = scaleCurrent(applyFilter(axis.currentFilter, axis.currentRaw,
+                                              systemParams.currentFilter, dt));
+    
+    // Trip on out of range inputs here, before the outputs are updated. The
+    // hardware latch is taken on every pass so it never outlives the alarm.
+    bool fastTrip = takeFastTrip(axis);
+    axis.overcurrent = (axis.currentRaw >= inputScaling.overcurrentRaw) || fastTrip;
+    if (axis.overcurrent) {
+        raiseAlarm(axis, ALARM_OVERCURRENT);
+    } else if (axis.speed > inputScaling.overspeedRpm) {
+        raiseAlarm(axis, ALARM_OVERSPEED);
+    }
+}
 
-// RGB LED colors for different states
-void setStateColor(SystemState state) {
+// Write the motor PWM output only when the value changes
+void setMotorPwm(MotorAxis& axis, uint8_t pwm) {
+    // Keep a hardware trip in force until readInputs() takes it
+    if (isFastTripped(axis)) {
+        pwm = 0;
+    }
+    if (pwm != axis.pwm) {
+        analogWrite(axis.pins->pwm, pwm);
+        axis.pwm = pwm;
+    }
+}
+
+// Request soft start, only accepted in IDLE
+void startMotor(MotorAxis& axis) {
+    postStateEvent(axis, EVT_START);
+}
+
+// Request stop sequence, accepted while starting or running
+void stopMotor(MotorAxis& axis) {
+    postStateEvent(axis, EVT_STOP);
+}
+
+bool isMotorRunning(const MotorAxis& axis) {
+    return axis.state == STATE_STARTING ||
+           axis.state == STATE_RUN ||
+           axis.state == STATE_STOPPING;
+}
+
+// Ramp PWM towards the open loop estimate for the setpoint, then hand over
+// to the PID. The ramp holds while the current is above the soft start limit;
+// a start that has not finished after SOFT_START_TIMEOUT faults the axis.
+static void updateSoftStart(MotorAxis& axis, unsigned long elapsed) {
+    double target = getFeedforward(axis);
+
+    if (millis() - axis.stateEnterTime >= SOFT_START_TIMEOUT) {
+        raiseAlarm(axis, ALARM_START_TIMEOUT);
+        return;
+    }
+
+    if (axis.currentRaw < inputScaling.softStartLimitRaw) {
+        axis.pidOutput += (double)PID_OUTPUT_MAX * elapsed / SOFT_START_TIME;
+    }
+
+    if (axis.pidOutput >= target || axis.speed >= axis.pidSetpoint) {
+        if (axis.pidOutput > target) {
+            axis.pidOutput = target;
+        }
+        setMotorPwm(axis, axis.pidOutput);
+        dispatchStateEvent(axis, EVT_STARTED);
+        return;
+    }
+    setMotorPwm(axis, axis.pidOutput);
+}
+
+// Coast, or ramp PWM down at the controlled stop rate
+static void updateStopping(MotorAxis& axis, unsigned long elapsed) {
+    double step = (double)PID_OUTPUT_MAX * elapsed / STOP_RAMP_TIME;
+
+    if (systemParams.stopMode == STOP_MODE_COAST || axis.pidOutput <= step) {
+        dispatchStateEvent(axis, EVT_STOPPED);
+        return;
+    }
+    axis.pidOutput -= step;
+    setMotorPwm(axis, axis.pidOutput);
+}
+
+// Transition table
+#define STATE_TRANSITION_ROW(from, event, to) { from, event, to },
+static const StateTransition STATE_TRANSITIONS[] PROGMEM = {
+    STATE_TRANSITION_LIST(STATE_TRANSITION_ROW)
+};
+const uint8_t STATE_TRANSITION_COUNT = sizeof(STATE_TRANSITIONS) / sizeof(STATE_TRANSITIONS[0]);
+
+// Entry actions
+static void enterState(MotorAxis& axis, SystemState state) {
     switch(state) {
         case STATE_IDLE:
-            digitalWrite(RGB_BLUE_PIN, LOW);
-            digitalWrite(RGB_RED_PIN, LOW);
-            digitalWrite(RGB_GREEN_PIN, HIGH);
+        case STATE_ALARM:
+            // Motor off, the PID restarts from zero on the next start
+            resetPID(axis);
+            setMotorPwm(axis, 0);
             break;
+
+        case STATE_STARTING:
+            // The soft start ramps the output with the loop open
+            resetPID(axis);
+            break;
+
         case STATE_RUN:
-            digitalWrite(RGB_BLUE_PIN, HIGH);
-            digitalWrite(RGB_RED_PIN, LOW);
-            digitalWrite(RGB_GREEN_PIN, LOW);
+            startPID(axis);  // Integral preloaded from the ramp output
             break;
-        case STATE_ALARM:
-            digitalWrite(RGB_BLUE_PIN, LOW);
-            digitalWrite(RGB_RED_PIN, HIGH);
-            digitalWrite(RGB_GREEN_PIN, LOW);
+
+        case STATE_STOPPING:
+            // The stop ramp starts from the last output, with the loop open
+            axis.pid.active = false;
+            break;
+
+        default:
             break;
     }
 }
 
-// Read analog inputs and convert to actual values
-void readInputs() {
-    // Read speed input
-    int speedRaw = analogRead(SPEED_SENSE_PIN);
-    currentSpeed = mapf(speedRaw, 0, ADC_RESOLUTION-1, 0, systemParams.speedFullScale);
-    
-    // Read current input
-    int currentRaw = analogRead(CURRENT_SENSE_PIN);
-    currentCurrent = mapf(currentRaw, 0, ADC_RESOLUTION-1, 0, systemParams.currentFullScale);
-    
-    // Check for overcurrent condition
-    isOvercurrent = (currentCurrent >= (systemParams.currentFullScale * OVERCURRENT_THRESHOLD));
+// Exit actions
+static void exitState(MotorAxis& axis, SystemState state) {
+    switch(state) {
+        case STATE_ALARM:
+            axis.alarm = ALARM_NONE;
+            break;
+
+        default:
+            break;
+    }
 }
 
-// Alarm handling
-void handleAlarm() {
-    static unsigned long lastBuzzerToggle = 0;
-    static bool buzzerState = false;
-    
-    if (currentState == STATE_ALARM) {
-        unsigned long currentMillis = millis();
-        if (currentMillis - lastBuzzerToggle >= ALARM_BUZZER_INTERVAL) {
-            buzzerState = !buzzerState;
-            if (buzzerState) {
-                tone(BUZZER_PIN, ALARM_BUZZER_FREQ);
-            } else {
-                noTone(BUZZER_PIN);
-            }
-            lastBuzzerToggle = currentMillis;
+// Apply an event through the transition table
+void dispatchStateEvent(MotorAxis& axis, StateEvent event) {
+    StateTransition transition;
+
+    for (uint8_t i = 0; i < STATE_TRANSITION_COUNT; i++) {
+        memcpy_P(&transition, &STATE_TRANSITIONS[i], sizeof(transition));
+        if (transition.from != axis.state || transition.event != event) {
+            continue;
         }
-    } else {
-        noTone(BUZZER_PIN);
-        buzzerState = false;
+
+        SystemState from = axis.state;
+        SystemState to = (SystemState)transition.to;
+        exitState(axis, from);
+        axis.state = to;
+        axis.stateEnterTime = millis();
+        enterState(axis, to);
+        logStateChange(axis, from, to);
+        return;
     }
 }
 
-// State machine update
-void updateStateMachine() {
-    
-    // Check for alarm conditions
-    if (isOvercurrent) {
-        currentState = STATE_ALARM;
+// Queue an event, dropping it if the queue is full
+void postStateEvent(MotorAxis& axis, StateEvent event) {
+    if (axis.eventCount >= STATE_EVENT_QUEUE_SIZE) {
+        return;
     }
-    
+    axis.eventQueue[(axis.eventHead + axis.eventCount) % STATE_EVENT_QUEUE_SIZE] = event;
+    axis.eventCount++;
+}
+
+// State machine update: handle queued events, then run the current state
+void updateStateMachine(MotorAxis& axis) {
+    unsigned long currentMillis = millis();
+    unsigned long elapsed = currentMillis - axis.lastStateUpdate;
+    axis.lastStateUpdate = currentMillis;
+
+    while (axis.eventCount > 0) {
+        StateEvent event = (StateEvent)axis.eventQueue[axis.eventHead];
+        axis.eventHead = (axis.eventHead + 1) % STATE_EVENT_QUEUE_SIZE;
+        axis.eventCount--;
+        dispatchStateEvent(axis, event);
+    }
+
     // State-specific behavior
-    switch(currentState) {
-        case STATE_IDLE:
-            analogWrite(MOTOR_PWM_PIN, 0);
+    switch(axis.state) {
+        case STATE_STARTING:
+            updateSoftStart(axis, elapsed);
             break;
-            
-        case STATE_RUN:
-            // Motor control handled by PID
-            if (isOvercurrent) {
-                currentState = STATE_ALARM;
-            }
+
+        case STATE_STOPPING:
+            updateStopping(axis, elapsed);
             break;
-            
-        case STATE_ALARM:
-            analogWrite(MOTOR_PWM_PIN, 0);
-            // Can only exit ALARM state by going to IDLE
+
+        default:
+            // IDLE and ALARM hold the output off, RUN is handled by the PID
             break;
     }
-    
-    // Update RGB LED if state changed
-    if (previousState != currentState) {
-        previousState = currentState;
-        setStateColor(currentState);
+}
+
+// Short state name for logs and display
+const __FlashStringHelper* getStateText(SystemState state) {
+    switch(state) {
+        case STATE_IDLE:
+            return F("IDLE");
+        case STATE_RUN:
+            return F("RUN");
+        case STATE_ALARM:
+            return F("ALARM");
+        case STATE_STARTING:
+            return F("START");
+        case STATE_STOPPING:
+            return F("STOP");
+        default:
+            return F("---");
     }
-    
-    // Handle alarm buzzer
-    handleAlarm();
-} 
\ No newline at end of file
+}
@@ -1,5 +1,11 @@
 /*
  * State machine declarations for DC Motor Speed Control Project
+ *
+ * Each axis runs a table driven state machine. Requests from the user
+ * interface are queued and handled at the next updateStateMachine(); faults
+ * found while sampling the inputs are dispatched at once, so the PWM is off
+ * before the rest of the loop runs. Outputs are only changed by the entry
+ * and exit actions of a state and by the ramps of STARTING and STOPPING.
  */
 
 #ifndef STATES_H
@@ -13,18 +19,55 @@ enum SystemState {
     STATE_UNDEFINED,
     STATE_IDLE,    // Motor stopped, system ready
     STATE_RUN,     // Motor running with PID control
-    STATE_ALARM    // Alarm condition, motor stopped
+    STATE_ALARM,   // Alarm condition, motor stopped
+    STATE_STARTING,  // Soft start PWM ramp before PID control
+    STATE_STOPPING   // Coast or controlled PWM ramp down
 };
 
-// External declarations for system measurements
-extern float currentSpeed;    // Current motor speed in RPM
-extern float currentCurrent;  // Current motor current in Ampere
-extern bool isOvercurrent;    // Overcurrent condition flag
+// State machine events
+enum StateEvent {
+    EVT_START,     // Start requested
+    EVT_STOP,      // Stop requested
+    EVT_STARTED,   // Soft start ramp complete
+    EVT_STOPPED,   // Stop ramp complete
+    EVT_FAULT,     // Alarm raised, dispatched immediately
+    EVT_CLEAR      // Alarm condition gone
+};
+
+// State transitions, events without a row are ignored:
+//   X(from, event, to)
+#define STATE_TRANSITION_LIST(X) \
+    X(STATE_IDLE,     EVT_START,   STATE_STARTING) \
+    X(STATE_STARTING, EVT_STARTED, STATE_RUN) \
+    X(STATE_STARTING, EVT_STOP,    STATE_STOPPING) \
+    X(STATE_RUN,      EVT_STOP,    STATE_STOPPING) \
+    X(STATE_STOPPING, EVT_STOPPED, STATE_IDLE) \
+    X(STATE_IDLE,     EVT_FAULT,   STATE_ALARM) \
+    X(STATE_STARTING, EVT_FAULT,   STATE_ALARM) \
+    X(STATE_RUN,      EVT_FAULT,   STATE_ALARM) \
+    X(STATE_STOPPING, EVT_FAULT,   STATE_ALARM) \
+    X(STATE_ALARM,    EVT_CLEAR,   STATE_IDLE)
+
+// State transition descriptor (flash)
+struct StateTransition {
+    uint8_t from;    // SystemState
+    uint8_t event;   // StateEvent
+    uint8_t to;      // SystemState
+};
+
+const uint8_t STATE_EVENT_QUEUE_SIZE = 4;  // Events waiting per axis
+
+struct MotorAxis;  // See axis.h
 
 // State machine functions
-void setStateColor(SystemState state);   // Set RGB LED color based on state
-void readInputs();                       // Read and process analog inputs
-void handleAlarm();                      // Handle alarm conditions
-void updateStateMachine();               // Update system state
+void readInputs(MotorAxis& axis);        // Read and process analog inputs
+void updateStateMachine(MotorAxis& axis);  // Handle queued events and run the state
+void postStateEvent(MotorAxis& axis, StateEvent event);      // Queue for updateStateMachine()
+void dispatchStateEvent(MotorAxis& axis, StateEvent event);  // Apply now
+void startMotor(MotorAxis& axis);        // Request soft start from IDLE
+void stopMotor(MotorAxis& axis);         // Request stop sequence
+bool isMotorRunning(const MotorAxis& axis);  // True while starting, running or stopping
+void setMotorPwm(MotorAxis& axis, uint8_t pwm);  // Write PWM output only on change
+const __FlashStringHelper* getStateText(SystemState state);  // Short state name
 
 #endif 
\ No newline at end of file
@@ -0,0 +1,39 @@
+/*
+ * Periodic tick implementation for DC Motor Speed Control Project
+ *
+ * TCB2 runs in periodic interrupt mode from the peripheral clock. It is not
+ * used by the Nano Every core (millis() runs on TCB3, tone() on TCB1 and
+ * PWM on TCA0/TCB0). Work done in the interrupt must stay short: it only
+ * samples inputs and dithers the LED bar, everything else runs from loop().
+ */
+
+#include "tick.h"
+#include <Arduino.h>
+#include "buttons.h"
+#include "led_bar.h"
+
+volatile uint32_t tickCount = 0;
+
+// Start the periodic tick interrupt
+void initializeTick() {
+    TCB2.CTRLA = 0;
+    TCB2.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB2.CCMP = F_CPU / TICK_FREQUENCY - 1;
+    TCB2.CNT = 0;
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    TCB2.INTCTRL = TCB_CAPT_bm;
+    TCB2.CTRLA = TCB_CLKSEL_CLKDIV1_gc | TCB_ENABLE_bm;
+}
+
+ISR(TCB2_INT_vect) {
+    static uint8_t buttonDivider = 0;
+
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    tickCount++;
+
+    if (++buttonDivider >= BUTTON_SAMPLE_TICKS) {
+        buttonDivider = 0;
+        sampleButtons();
+    }
+    serviceLedDither();
+}
@@ -0,0 +1,20 @@
+/*
+ * Periodic tick declarations for DC Motor Speed Control Project
+ */
+
+#ifndef TICK_H
+#define TICK_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Tick timing
+const uint16_t TICK_FREQUENCY = 1000;  // Tick interrupt rate in Hz (1 ms period)
+
+// External declarations
+extern volatile uint32_t tickCount;    // Ticks since initializeTick()
+
+// Function declarations
+void initializeTick();
+
+#endif
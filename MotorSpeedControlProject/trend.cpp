@@ -0,0 +1,78 @@
+/*
+ * Trend recorder implementation for DC Motor Speed Control Project
+ *
+ * Speed and current of the selected axis are averaged over TREND_SAMPLE_INTERVAL and stored,
+ * already scaled to plot pixels, in a ring buffer holding one sample per
+ * display column. The display only draws the samples added since its last
+ * refresh.
+ */
+
+#include "trend.h"
+#include "globals.h"
+#include "scaling.h"  // For inputScaling
+#include "axis.h"     // For activeAxis()
+
+static TrendSample trendBuffer[TREND_SAMPLES];
+static uint8_t trendHead = 0;        // Slot to be written next
+static uint8_t trendCount = 0;       // Valid samples
+static uint16_t trendSequence = 0;   // Samples recorded since boot
+
+// Scale a value to 0..height-1 pixels of its full scale
+static uint8_t scaleToPlot(uint32_t value, uint32_t fullScale, uint8_t height) {
+    if (value == 0 || fullScale == 0) {
+        return 0;
+    }
+    if (value >= fullScale) {
+        return height - 1;
+    }
+    return (value * (height - 1) + fullScale / 2) / fullScale;
+}
+
+// Accumulate inputs, called every loop pass
+void sampleTrend() {
+    static unsigned long lastSample = 0;
+    static uint32_t speedSum = 0;
+    static uint32_t currentSum = 0;
+    static uint16_t sumCount = 0;
+    unsigned long currentMillis = millis();
+    const MotorAxis& axis = activeAxis();
+
+    speedSum += axis.speed;
+    currentSum += axis.milliAmps;
+    sumCount++;
+
+    if (currentMillis - lastSample < TREND_SAMPLE_INTERVAL) {
+        return;
+    }
+    lastSample = currentMillis;
+
+    TrendSample& sample = trendBuffer[trendHead];
+    sample.speed = scaleToPlot(speedSum / sumCount, systemParams.speedFullScale, TREND_SPEED_HEIGHT);
+    sample.setpoint = isMotorRunning(axis) ?
+        scaleToPlot((uint16_t)axis.pidSetpoint, systemParams.speedFullScale, TREND_SPEED_HEIGHT) : 0;
+    sample.current = scaleToPlot(currentSum / sumCount, inputScaling.currentFullScaleMilliAmps,
+                                 TREND_CURRENT_HEIGHT);
+
+    trendHead = (trendHead + 1) % TREND_SAMPLES;
+    if (trendCount < TREND_SAMPLES) {
+        trendCount++;
+    }
+    trendSequence++;
+
+    speedSum = 0;
+    currentSum = 0;
+    sumCount = 0;
+}
+
+uint16_t getTrendSequence() {
+    return trendSequence;
+}
+
+// Read a recorded sample, age 0 is the newest
+bool readTrendSample(uint8_t age, TrendSample& sample) {
+    if (age >= trendCount) {
+        return false;
+    }
+    sample = trendBuffer[(trendHead + TREND_SAMPLES - 1 - age) % TREND_SAMPLES];
+    return true;
+}
@@ -0,0 +1,29 @@
+/*
+ * Trend recorder declarations for DC Motor Speed Control Project
+ */
+
+#ifndef TREND_H
+#define TREND_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Trend configuration
+const uint8_t TREND_SAMPLES = 128;                  // One sample per display column
+const unsigned long TREND_SAMPLE_INTERVAL = 250;    // Decimation period in ms (32 s window)
+const uint8_t TREND_SPEED_HEIGHT = 32;              // Speed/setpoint plot height in pixels
+const uint8_t TREND_CURRENT_HEIGHT = 16;            // Current plot height in pixels
+
+// Decimated sample, values in plot pixels from the bottom of each plot
+struct TrendSample {
+    uint8_t speed;
+    uint8_t setpoint;
+    uint8_t current;
+};
+
+// Function declarations
+void sampleTrend();
+uint16_t getTrendSequence();                              // Incremented on every new sample
+bool readTrendSample(uint8_t age, TrendSample& sample);   // age 0 = newest
+
+#endif
@@ -3,55 +3,43 @@
  */
 
 #include "utils.h"
-#include "globals.h"
-#include "pid.h"
 
-// Function to adjust selected parameter value
-void adjustSelectedValue(bool increase) {
-    switch(selectedItem) {
-        case ITEM_CURRENT_FS:
-            if (increase) {
-                systemParams.currentFullScale += CURRENT_FS_STEP;
-            } else {
-                systemParams.currentFullScale = max(CURRENT_FS_STEP, 
-                    systemParams.currentFullScale - CURRENT_FS_STEP);
-            }
-            break;
-            
-        case ITEM_SPEED_FS:
-            if (increase) {
-                systemParams.speedFullScale += SPEED_FS_STEP;
-            } else {
-                systemParams.speedFullScale = max(SPEED_FS_STEP, 
-                    systemParams.speedFullScale - SPEED_FS_STEP);
-            }
-            break;
-            
-        case ITEM_PID_P:
-            if (increase) {
-                systemParams.kp += PID_P_STEP;
-            } else {
-                systemParams.kp = max(0.0f, systemParams.kp - PID_P_STEP);
-            }
-            updatePIDParameters();
-            break;
-            
-        case ITEM_PID_I:
-            if (increase) {
-                systemParams.ki += PID_I_STEP;
-            } else {
-                systemParams.ki = max(0.0f, systemParams.ki - PID_I_STEP);
-            }
-            updatePIDParameters();
-            break;
-            
-        case ITEM_PID_D:
-            if (increase) {
-                systemParams.kd += PID_D_STEP;
-            } else {
-                systemParams.kd = max(0.0f, systemParams.kd - PID_D_STEP);
+// Function to print a fixed-point value holding 10^decimals units per unit,
+// e.g. 123 with 1 decimal prints "12.3". The text is right-aligned to
+// 'width' characters with leading spaces.
+void printFixed(Print& out, int32_t value, uint8_t decimals, uint8_t width) {
+    char digits[14];
+    uint8_t length = 0;
+    bool negative = value < 0;
+    uint32_t magnitude = negative ? -(uint32_t)value : (uint32_t)value;
+
+    // Digits from the right, with at least one digit before the point
+    do {
+        digits[length++] = '0' + magnitude % 10;
+        magnitude /= 10;
+        if (length == decimals) {
+            digits[length++] = '.';
+            if (magnitude == 0) {
+                digits[length++] = '0';
             }
-            updatePIDParameters();
-            break;
+        }
+    } while (magnitude > 0 || length < decimals);
+
+    if (negative) {
+        digits[length++] = '-';
+    }
+
+    while (width > length) {
+        out.write(' ');
+        width--;
     }
-} 
\ No newline at end of file
+    while (length > 0) {
+        out.write(digits[--length]);
+    }
+}
+
+// Function to round a float to a fixed-point value with 1 or 2 decimals
+int32_t toFixed(float value, uint8_t decimals) {
+    float scale = (decimals == 2) ? 100.0f : (decimals == 1) ? 10.0f : 1.0f;
+    return (int32_t)(value * scale + (value < 0 ? -0.5f : 0.5f));
+}
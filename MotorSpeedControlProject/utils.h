@@ -1,21 +1,24 @@
 /*
  * Utility functions declarations for DC Motor Speed Control Project
+ *
+ * Text is written straight to a Print (the display or a serial port):
+ * fixed strings stay in flash and numbers are formatted without printf.
  */
 
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
+#include <Arduino.h>  // For Print and __FlashStringHelper
 #include "config.h"
-#include "menu.h"
 
-// Value adjustment step sizes
-const float CURRENT_FS_STEP = 0.5;    // Ampere
-const int SPEED_FS_STEP = 100;        // RPM
-const float PID_P_STEP = 0.1;
-const float PID_I_STEP = 0.01;
-const float PID_D_STEP = 0.001;
+// Flash string pointer (PGM_P) as printable F() string
+#ifndef FPSTR
+#define FPSTR(p) (reinterpret_cast<const __FlashStringHelper*>(p))
+#endif
 
 // Function declarations
-void adjustSelectedValue(bool increase);
+void printFixed(Print& out, int32_t value, uint8_t decimals = 0, uint8_t width = 0);
+int32_t toFixed(float value, uint8_t decimals);
 
-#endif 
\ No newline at end of file
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Watchdog and loop supervision implementation for DC Motor Speed Control Project
+ */
+
+#include "watchdog.h"
+#include <avr/wdt.h>
+#include "event_log.h"
+#include "display.h"  // For showMessage()
+
+static uint8_t resetCause = 0;
+static unsigned long bootTime = 0;
+static unsigned long lastControlPass = 0;
+static uint16_t loopOverruns = 0;
+static uint16_t longestLoop = 0;
+
+// Record the reset cause and start the watchdog, called from setup() as soon
+// as the control loop is ready to run
+void initializeWatchdog() {
+    // micros() starts with the core timer, a few hundred us after reset
+    bootTime = micros();
+
+    resetCause = RSTCTRL.RSTFR;
+    RSTCTRL.RSTFR = resetCause;  // Flags are cleared by writing ones
+
+    // A power-on reset clears the other flags; only unexpected resets are
+    // logged, and shown instead of the splash screen
+    if (isWarmReset()) {
+        if (resetCause & (RSTCTRL_WDRF_bm | RSTCTRL_BORF_bm | RSTCTRL_SWRF_bm)) {
+            logReset(resetCause);
+        }
+        showMessage(getResetCauseText(resetCause));
+    }
+
+    lastControlPass = millis();
+    _PROTECTED_WRITE(WDT.CTRLA, WATCHDOG_PERIOD);
+}
+
+// Feed the watchdog if the control task ran on schedule, called after the
+// control task of every loop pass
+void feedWatchdog() {
+    unsigned long currentMillis = millis();
+    unsigned long period = currentMillis - lastControlPass;
+    lastControlPass = currentMillis;
+
+    if (period > longestLoop) {
+        longestLoop = period > 0xFFFF ? 0xFFFF : period;
+    }
+    if (period > LOOP_DEADLINE) {
+        loopOverruns++;
+        return;
+    }
+    wdt_reset();
+}
+
+uint8_t getResetCause() {
+    return resetCause;
+}
+
+bool isWarmReset() {
+    return !(resetCause & RSTCTRL_PORF_bm);
+}
+
+unsigned long getBootTime() {
+    return bootTime;
+}
+
+// Function to get the description of a reset cause, most specific flag first
+const __FlashStringHelper* getResetCauseText(uint8_t cause) {
+    if (cause & RSTCTRL_WDRF_bm) {
+        return F("Reset: watchdog");
+    } else if (cause & RSTCTRL_BORF_bm) {
+        return F("Reset: brown-out");
+    } else if (cause & RSTCTRL_SWRF_bm) {
+        return F("Reset: software");
+    } else if (cause & RSTCTRL_UPDIRF_bm) {
+        return F("Reset: programmer");
+    } else if (cause & RSTCTRL_EXTRF_bm) {
+        return F("Reset: button");
+    }
+    return F("Reset: power-on");
+}
+
+// Function to get the short name of a reset cause, for the event log
+const __FlashStringHelper* getResetTypeText(uint8_t cause) {
+    if (cause & RSTCTRL_WDRF_bm) {
+        return F("WDT");
+    } else if (cause & RSTCTRL_BORF_bm) {
+        return F("BOR");
+    } else if (cause & RSTCTRL_SWRF_bm) {
+        return F("SW");
+    } else if (cause & RSTCTRL_UPDIRF_bm) {
+        return F("UPDI");
+    } else if (cause & RSTCTRL_EXTRF_bm) {
+        return F("EXT");
+    }
+    return F("POR");
+}
+
+uint16_t getLoopOverruns() {
+    return loopOverruns;
+}
+
+uint16_t getLongestLoop() {
+    return longestLoop;
+}
+
+// Print boot and loop timing as key=value lines
+void printLoopStats(Print& out) {
+    out.print(F("boot_ready_us="));
+    out.println(bootTime);
+    out.print(F("loop_max_ms="));
+    out.println(longestLoop);
+    out.print(F("loop_overruns="));
+    out.println(loopOverruns);
+}
@@ -0,0 +1,35 @@
+/*
+ * Watchdog and loop supervision declarations for DC Motor Speed Control Project
+ *
+ * The hardware watchdog is fed only from the control task, and only when the
+ * task completed within LOOP_DEADLINE of its previous run. A loop that hangs
+ * (e.g. in a blocked I2C transfer) or keeps overrunning its deadline stops
+ * feeding the watchdog and the MCU resets; all pins go to high impedance and
+ * setup() drives the motor PWM low before anything else.
+ */
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <stdint.h>
+#include <Arduino.h>  // For __FlashStringHelper
+#include "config.h"
+
+// Watchdog timing
+const unsigned long LOOP_DEADLINE = 200;  // Longest allowed control period in ms
+// The watchdog period (~0.5 s) must cover a few late passes in a row
+const uint8_t WATCHDOG_PERIOD = WDT_PERIOD_512CLK_gc;
+
+// Function declarations
+void initializeWatchdog();
+void feedWatchdog();
+uint8_t getResetCause();                      // RSTCTRL.RSTFR flags at boot
+bool isWarmReset();                           // Reset without power loss
+unsigned long getBootTime();                  // Reset to control ready in us
+const __FlashStringHelper* getResetCauseText(uint8_t cause);  // Boot message
+const __FlashStringHelper* getResetTypeText(uint8_t cause);   // Short name
+uint16_t getLoopOverruns();                   // Passes later than LOOP_DEADLINE
+uint16_t getLongestLoop();                    // Longest control period in ms
+void printLoopStats(Print& out);
+
+#endif
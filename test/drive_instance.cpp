@@ -0,0 +1,82 @@
+/*
+ * One drive of the sync simulator, see test_sync.cpp
+ *
+ * Built with the firmware into a shared library that test_sync loads once
+ * per drive with dlmopen(), so every drive has its own firmware globals,
+ * clock, serial ports and motor. The functions below are its interface.
+ */
+
+#include "host_firmware.h"
+#include "pid.h"
+#include "speed_sync.h"
+
+static MotorModel motor;
+
+extern "C" {
+
+void driveSetup(uint8_t syncMode, float ratio, int trim) {
+    char output[256];
+
+    motor = defaultMotor();
+    setup();
+    systemParams.syncMode = syncMode;
+    systemParams.syncRatio = ratio;
+    systemParams.syncTrim = trim;
+    systemParams.kp = 0.1;
+    systemParams.ki = 0.8;
+    updatePIDParameters();
+    takeOutput(output, sizeof(output));
+}
+
+// Run the firmware and the motor, the USB serial output is dropped
+void driveRun(unsigned long ms) {
+    char output[256];
+
+    runFirmware(motor, ms);
+    takeOutput(output, sizeof(output));
+}
+
+void driveStart(uint16_t setpoint) {
+    setSpeedSetpoint(activeAxis(), setpoint);
+    startMotor(activeAxis());
+}
+
+void driveSetSetpoint(uint16_t setpoint) {
+    setSpeedSetpoint(activeAxis(), setpoint);
+}
+
+// Move the motor to a speed at once, as a slipping coupling would
+void driveSetMotorSpeed(float rpm) {
+    motor.rpm = rpm;
+}
+
+// Sync link, Serial1
+int driveLinkTake() {
+    return Serial1.hostTake();
+}
+
+void driveLinkReceive(uint8_t c) {
+    Serial1.hostReceive(c);
+}
+
+uint16_t driveSpeed() {
+    return activeAxis().speed;
+}
+
+float driveSetpoint() {
+    return activeAxis().pidSetpoint;
+}
+
+uint8_t driveState() {
+    return activeAxis().state;
+}
+
+uint8_t driveAlarm() {
+    return activeAxis().alarm;
+}
+
+uint16_t driveLostFrames() {
+    return getSyncLostFrames();
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+ * Host harness for tests that run the whole firmware
+ *
+ * The sketch runs unchanged against the stand-ins in stubs/: every loop()
+ * pass moves time by HOST_LOOP_TIME, and the motor model in between turns
+ * the PWM output of the axis into speed and current readings. Commands go
+ * in and replies come out through the USB serial FIFOs.
+ */
+
+#ifndef HOST_FIRMWARE_H
+#define HOST_FIRMWARE_H
+
+#include <Arduino.h>
+#include <string.h>
+#include "axis.h"
+#include "globals.h"
+
+void setup();
+void loop();
+
+const unsigned long HOST_LOOP_TIME = 1000;   // Simulated duration of one loop() pass in us
+
+// Permanent magnet DC motor on a synchronous half bridge, so the PWM also
+// brakes; armature inductance neglected. The load and friction are given
+// as the armature current they take.
+struct MotorModel {
+    float supplyVolts;       // Supply at 100% PWM
+    float ohms;              // Armature resistance
+    float voltsPerRpm;       // Back EMF constant
+    float rpmPerAmpSecond;   // Acceleration per A of net torque current
+    float loadAmps;          // Load torque, as armature current
+    float frictionAmps;      // Friction torque while turning
+    float noiseRpm;          // Peak uniform noise on the speed reading
+    float rpm;
+    float amps;
+    uint32_t seed;
+};
+
+// A 48 V motor of 3200 RPM no-load speed, 32 A stall current and 0.2 s
+// mechanical time constant
+static inline MotorModel defaultMotor() {
+    MotorModel motor;
+    motor.supplyVolts = 48.0f;
+    motor.ohms = 1.5f;
+    motor.voltsPerRpm = 48.0f / 3200;
+    motor.rpmPerAmpSecond = 500.0f;
+    motor.loadAmps = 0;
+    motor.frictionAmps = 0;
+    motor.noiseRpm = 0;
+    motor.rpm = 0;
+    motor.amps = 0;
+    motor.seed = 1;
+    return motor;
+}
+
+// Steady state speed per PWM count with no load
+static inline float motorGain(const MotorModel& motor) {
+    return motor.supplyVolts / PID_OUTPUT_MAX / motor.voltsPerRpm;
+}
+
+// Time constant of the speed response in s
+static inline float motorTau(const MotorModel& motor) {
+    return motor.ohms / (motor.rpmPerAmpSecond * motor.voltsPerRpm);
+}
+
+// Advance the motor by dt seconds at the given PWM
+static inline void stepMotor(MotorModel& motor, uint8_t pwm, float dt) {
+    float volts = motor.supplyVolts * pwm / PID_OUTPUT_MAX;
+    motor.amps = (volts - motor.voltsPerRpm * motor.rpm) / motor.ohms;  // Negative while braking
+    float torque = motor.amps - motor.loadAmps - (motor.rpm > 0 ? motor.frictionAmps : 0);
+    motor.rpm += motor.rpmPerAmpSecond * torque * dt;
+    if (motor.rpm < 0) {
+        motor.rpm = 0;
+    }
+}
+
+// Convert a value to ADC counts of the given full scale
+static inline uint16_t toCounts(float value, float fullScale) {
+    float counts = value * ADC_RESOLUTION / fullScale + 0.5f;
+    return counts < 0 ? 0 : (counts > ADC_RESOLUTION - 1 ? ADC_RESOLUTION - 1 : (uint16_t)counts);
+}
+
+// Present the motor state on the sensor inputs of an axis
+static inline void writeSensors(MotorModel& motor, const MotorAxis& axis) {
+    float noise = 0;
+    if (motor.noiseRpm > 0) {
+        motor.seed = motor.seed * 1103515245u + 12345u;
+        noise = motor.noiseRpm * (((motor.seed >> 16) & 0x7FFF) / 16383.5f - 1);
+    }
+    hostAnalog[axis.pins->speedSense] = toCounts(motor.rpm + noise, systemParams.speedFullScale);
+    hostAnalog[axis.pins->currentSense] = toCounts(motor.amps, systemParams.currentFullScale);
+}
+
+// Run loop() for the given time with the motor on the active axis
+static inline void runFirmware(MotorModel& motor, unsigned long ms) {
+    for (unsigned long t = 0; t < ms * 1000; t += HOST_LOOP_TIME) {
+        MotorAxis& axis = activeAxis();
+        stepMotor(motor, axis.pwm, HOST_LOOP_TIME * 1e-6f);
+        writeSensors(motor, axis);
+        hostAdvance(HOST_LOOP_TIME);
+        loop();
+    }
+}
+
+// Queue a command line on the USB serial input
+static inline void sendCommand(const char* command) {
+    while (*command) {
+        Serial.hostReceive(*command++);
+    }
+    Serial.hostReceive('\n');
+}
+
+// Collect what the firmware sent on the USB serial port
+static inline size_t takeOutput(char* text, size_t size) {
+    size_t length = 0;
+    int c;
+    while ((c = Serial.hostTake()) >= 0) {
+        if (length + 1 < size) {
+            text[length++] = c;
+        }
+    }
+    text[length] = '\0';
+    return length;
+}
+
+// Value of a key=value line in a report, or the fallback when missing
+static inline float reportValue(const char* report, const char* key, float fallback) {
+    size_t keyLength = strlen(key);
+    for (const char* line = report; line && *line; line = strchr(line, '\n')) {
+        while (*line == '\n' || *line == '\r') {
+            line++;
+        }
+        if (strncmp(line, key, keyLength) == 0 && line[keyLength] == '=') {
+            return atof(line + keyLength + 1);
+        }
+    }
+    return fallback;
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*
+ * Host stand-in for the Arduino core used by the firmware
+ *
+ * Time only moves when a test calls hostAdvance(), which also runs the
+ * TCB2 tick interrupt of the firmware on every ms boundary. Analog inputs read
+ * hostAnalog[], PWM writes land in hostPwm[]. Print formats like the
+ * Arduino core, and HardwareSerial keeps its transmitted bytes in a FIFO
+ * that a test can read back or forward to another port.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+#define RISING 3
+
+typedef uint8_t byte;
+
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    virtual int availableForWrite() { return 0; }
+
+    size_t print(const __FlashStringHelper* text);
+    size_t print(const char* text);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = 10);
+    size_t print(int value, int base = 10);
+    size_t print(unsigned int value, int base = 10);
+    size_t print(long value, int base = 10);
+    size_t print(unsigned long value, int base = 10);
+    size_t print(double value, int digits = 2);
+    size_t println();
+    template <class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <class T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+};
+
+const uint16_t HOST_SERIAL_BUFFER_SIZE = 1024;
+
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) { this->baud = baud; }
+    int available() { return rxCount; }
+    int read();
+    size_t write(uint8_t c);
+    using Print::write;
+    int availableForWrite() { return txCount + txRoom > HOST_SERIAL_BUFFER_SIZE ? HOST_SERIAL_BUFFER_SIZE - txCount : txRoom; }
+
+    // Host side
+    unsigned long baud = 0;
+    int txRoom = 64;                          // Free transmit buffer reported
+    bool hostReceive(uint8_t c);              // Queue a byte for read()
+    int hostTake();                           // Next transmitted byte, -1 if none
+
+private:
+    uint8_t rx[HOST_SERIAL_BUFFER_SIZE], tx[HOST_SERIAL_BUFFER_SIZE];
+    uint16_t rxHead = 0, rxCount = 0, txHead = 0, txCount = 0;
+};
+
+extern HardwareSerial Serial, Serial1;
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int value);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration = 0);
+void noTone(uint8_t pin);
+void attachInterrupt(uint8_t interrupt, void (*handler)(), int mode);
+void detachInterrupt(uint8_t interrupt);
+#define digitalPinToInterrupt(pin) (pin)
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+volatile uint8_t* portInputRegister(uint8_t port);
+void noInterrupts();
+void interrupts();
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+template <class T, class L> auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (b < a) ? b : a; }
+template <class T, class L> auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) { return (a < b) ? b : a; }
+
+// Host control
+const uint8_t HOST_PIN_COUNT = 24;
+extern uint16_t hostAnalog[HOST_PIN_COUNT];   // Value returned by analogRead()
+extern int hostPwm[HOST_PIN_COUNT];           // Last analogWrite() value
+void hostAdvance(unsigned long micros);       // Move time forward, running the 1 kHz tick
+void hostSetTime(unsigned long micros);
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ * Host stand-in for the EEPROM library: 256 cells in RAM, erased to 0xFF
+ */
+
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <stdint.h>
+#include <string.h>
+
+// RAM backed EEPROM, erased to 0xFF
+struct EEPROMClass {
+    uint8_t cells[256];
+
+    EEPROMClass() { memset(cells, 0xFF, sizeof(cells)); }
+    uint8_t read(int address) { return cells[address]; }
+    void write(int address, uint8_t value) { cells[address] = value; }
+    void update(int address, uint8_t value) { cells[address] = value; }
+    uint16_t length() { return sizeof(cells); }
+    template <class T> T& get(int address, T& value) {
+        memcpy(&value, cells + address, sizeof(T));
+        return value;
+    }
+    template <class T> const T& put(int address, const T& value) {
+        memcpy(cells + address, &value, sizeof(T));
+        return value;
+    }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,45 @@
+/*
+ * Host stand-in for the U8g2 display driver, draws nothing
+ */
+
+#ifndef HOST_U8G2LIB_H
+#define HOST_U8G2LIB_H
+
+#include <Arduino.h>
+
+#define U8G2_R0 0
+#define U8X8_PIN_NONE 255
+
+extern const uint8_t u8g2_font_6x10_tf[], u8g2_font_inb24_mf[], u8g2_font_4x6_tr[];
+
+// Display that keeps a frame buffer and draws nothing
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public Print {
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(int rotation, int reset) {}
+    size_t write(uint8_t c) { return 1; }
+    using Print::write;
+
+    bool begin() { return true; }
+    void setFont(const uint8_t* font) {}
+    void setFontPosTop() {}
+    void setFontDirection(uint8_t direction) {}
+    void setDrawColor(uint8_t color) {}
+    void setContrast(uint8_t contrast) {}
+    void setPowerSave(uint8_t on) {}
+    void setCursor(uint8_t x, uint8_t y) {}
+    void clearBuffer() { memset(buffer, 0, sizeof(buffer)); }
+    void sendBuffer() {}
+    void drawFrame(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {}
+    void drawHLine(uint8_t x, uint8_t y, uint8_t w) {}
+    void drawVLine(uint8_t x, uint8_t y, uint8_t h) {}
+    void drawPixel(uint8_t x, uint8_t y) {}
+    uint8_t getDisplayWidth() { return 128; }
+    uint8_t getDisplayHeight() { return 64; }
+    uint8_t* getBufferPtr() { return buffer; }
+    uint8_t getBufferTileHeight() { return 8; }
+
+private:
+    uint8_t buffer[1024];
+};
+
+#endif
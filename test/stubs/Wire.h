@@ -0,0 +1,3 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+#endif
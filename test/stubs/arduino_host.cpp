@@ -0,0 +1,143 @@
+/*
+ * Host stand-in for the Arduino core, see Arduino.h
+ */
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+static unsigned long hostMicros = 0;
+uint16_t hostAnalog[HOST_PIN_COUNT];
+int hostPwm[HOST_PIN_COUNT];
+
+HardwareSerial Serial, Serial1;
+EEPROMClass EEPROM;
+
+TCB_t TCB2;
+AC_t AC0;
+VREF_t VREF;
+RSTCTRL_t RSTCTRL;
+WDT_t WDT;
+ADC_t ADC0 = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ADC_RESRDY_bm, 0};  // Conversions complete at once
+VPORT_t VPORTA, VPORTB, VPORTC, VPORTD, VPORTE, VPORTF;
+TCA_t TCA0;
+volatile uint16_t SP = RAMEND;
+char __heap_start;
+char* __brkval;
+
+const uint8_t u8g2_font_6x10_tf[1] = {0}, u8g2_font_inb24_mf[1] = {0}, u8g2_font_4x6_tr[1] = {0};
+
+// Tick interrupt of the firmware, absent when a test links single modules
+extern "C" void TCB2_INT_vect(void) __attribute__((weak));
+
+void hostAdvance(unsigned long us) {
+    while (us > 0) {
+        unsigned long step = 1000 - hostMicros % 1000;
+        if (step > us) {
+            step = us;
+        }
+        hostMicros += step;
+        us -= step;
+        if (hostMicros % 1000 == 0 && TCB2_INT_vect) {
+            TCB2_INT_vect();
+        }
+    }
+}
+
+void hostSetTime(unsigned long us) { hostMicros = us; }
+unsigned long millis() { return hostMicros / 1000; }
+unsigned long micros() { return hostMicros; }
+void delay(unsigned long ms) { hostAdvance(ms * 1000); }
+
+void pinMode(uint8_t, uint8_t) {}
+void digitalWrite(uint8_t, uint8_t) {}
+int digitalRead(uint8_t) { return HIGH; }
+int analogRead(uint8_t pin) { return pin < HOST_PIN_COUNT ? hostAnalog[pin] : 0; }
+void analogWrite(uint8_t pin, int value) {
+    if (pin < HOST_PIN_COUNT) {
+        hostPwm[pin] = value;
+    }
+}
+void tone(uint8_t, unsigned int, unsigned long) {}
+void noTone(uint8_t) {}
+void attachInterrupt(uint8_t, void (*)(), int) {}
+void detachInterrupt(uint8_t) {}
+uint8_t digitalPinToPort(uint8_t) { return 0; }
+uint8_t digitalPinToBitMask(uint8_t pin) { return 1 << (pin & 7); }
+static volatile uint8_t hostPortInput = 0xFF;  // Pullups high, nothing pressed
+volatile uint8_t* portInputRegister(uint8_t) { return &hostPortInput; }
+void noInterrupts() {}
+void interrupts() {}
+
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) {
+        n += write(*buffer++);
+    }
+    return n;
+}
+
+static size_t printFormatted(Print& out, const char* format, ...) __attribute__((format(printf, 2, 3)));
+static size_t printFormatted(Print& out, const char* format, ...) {
+    char text[40];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    return out.print(text);
+}
+
+size_t Print::print(const __FlashStringHelper* text) { return print(reinterpret_cast<const char*>(text)); }
+size_t Print::print(const char* text) { return write((const uint8_t*)text, strlen(text)); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(int value, int base) { return print((long)value, base); }
+size_t Print::print(unsigned int value, int base) { return print((unsigned long)value, base); }
+size_t Print::print(long value, int base) {
+    return base == 16 ? printFormatted(*this, "%lX", value) : printFormatted(*this, "%ld", value);
+}
+size_t Print::print(unsigned long value, int base) {
+    return base == 16 ? printFormatted(*this, "%lX", value) : printFormatted(*this, "%lu", value);
+}
+size_t Print::print(double value, int digits) { return printFormatted(*this, "%.*f", digits, value); }
+size_t Print::println() { return print("\r\n"); }
+
+int HardwareSerial::read() {
+    if (rxCount == 0) {
+        return -1;
+    }
+    uint8_t c = rx[rxHead];
+    rxHead = (rxHead + 1) % HOST_SERIAL_BUFFER_SIZE;
+    rxCount--;
+    return c;
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (txCount >= HOST_SERIAL_BUFFER_SIZE) {
+        return 0;
+    }
+    tx[(txHead + txCount) % HOST_SERIAL_BUFFER_SIZE] = c;
+    txCount++;
+    return 1;
+}
+
+bool HardwareSerial::hostReceive(uint8_t c) {
+    if (rxCount >= HOST_SERIAL_BUFFER_SIZE) {
+        return false;
+    }
+    rx[(rxHead + rxCount) % HOST_SERIAL_BUFFER_SIZE] = c;
+    rxCount++;
+    return true;
+}
+
+int HardwareSerial::hostTake() {
+    if (txCount == 0) {
+        return -1;
+    }
+    uint8_t c = tx[txHead];
+    txHead = (txHead + 1) % HOST_SERIAL_BUFFER_SIZE;
+    txCount--;
+    return c;
+}
@@ -0,0 +1,69 @@
+/*
+ * Host stand-in for the ATmega4809 registers used by the firmware
+ */
+
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#define F_CPU 16000000UL
+
+typedef struct { volatile uint8_t CTRLA, CTRLB, EVCTRL, INTCTRL, INTFLAGS, STATUS, DBGCTRL, TEMP; volatile uint16_t CNT, CCMP; } TCB_t;
+extern TCB_t TCB2;
+#define TCB_CNTMODE_INT_gc 0x00
+#define TCB_CAPT_bm 0x01
+#define TCB_CLKSEL_CLKDIV1_gc 0x00
+#define TCB_ENABLE_bm 0x01
+
+typedef struct { volatile uint8_t CTRLA, MUXCTRLA, DACREF, INTCTRL, STATUS; } AC_t;
+extern AC_t AC0;
+#define AC_MUXPOS_PIN1_gc 0x08
+#define AC_MUXNEG_DACREF_gc 0x03
+#define AC_CMP_bm 0x01
+#define AC_ENABLE_bm 0x01
+#define AC_HYSMODE_50mV_gc 0x06
+#define AC_INTMODE_POSEDGE_gc 0x30
+
+typedef struct { volatile uint8_t CTRLA, CTRLB; } VREF_t;
+extern VREF_t VREF;
+#define VREF_AC0REFSEL_gm 0x07
+#define VREF_AC0REFSEL_4V34_gc 0x03
+#define VREF_AC0REFEN_bm 0x01
+
+typedef struct { volatile uint8_t RSTFR, SWRR; } RSTCTRL_t;
+extern RSTCTRL_t RSTCTRL;
+#define RSTCTRL_PORF_bm 0x01
+#define RSTCTRL_BORF_bm 0x02
+#define RSTCTRL_EXTRF_bm 0x04
+#define RSTCTRL_WDRF_bm 0x08
+#define RSTCTRL_SWRF_bm 0x10
+#define RSTCTRL_UPDIRF_bm 0x20
+
+typedef struct { volatile uint8_t CTRLA, STATUS; } WDT_t;
+extern WDT_t WDT;
+typedef enum { WDT_PERIOD_512CLK_gc = 0x07 } WDT_PERIOD_t;
+#define _PROTECTED_WRITE(reg, value) ((reg) = (value))
+
+typedef struct { volatile uint8_t CTRLA, CTRLB, CTRLC, CTRLD, CTRLE, SAMPCTRL, MUXPOS, COMMAND, EVCTRL, INTCTRL, INTFLAGS; volatile uint16_t RES; } ADC_t;
+extern ADC_t ADC0;
+#define ADC_SAMPNUM_ACC1_gc 0x00
+#define ADC_SAMPNUM_ACC4_gc 0x02
+#define ADC_MUXPOS_AIN9_gc 0x09
+#define ADC_STCONV_bm 0x01
+#define ADC_RESRDY_bm 0x01
+
+typedef struct { volatile uint8_t DIR, OUT, IN, INTFLAGS; } VPORT_t;
+extern VPORT_t VPORTA, VPORTB, VPORTC, VPORTD, VPORTE, VPORTF;
+
+typedef struct { volatile uint8_t CTRLA, CTRLB; } TCA_SPLIT_t;
+typedef union { TCA_SPLIT_t SPLIT; } TCA_t;
+extern TCA_t TCA0;
+
+extern volatile uint16_t SP;
+#define RAMSTART 0x2800
+#define RAMEND 0x3FFF
+
+#define ISR(vector) extern "C" void vector(void); void vector(void)
+
+#endif
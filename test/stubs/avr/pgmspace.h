@@ -0,0 +1,17 @@
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Flash and RAM share one address space on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(address) (*(const uint8_t*)(address))
+#define pgm_read_ptr(address) (*(void* const*)(address))
+typedef const char* PGM_P;
+
+inline void* memcpy_P(void* dest, const void* src, size_t n) { return memcpy(dest, src, n); }
+inline int strncmp_P(const char* a, const char* b, size_t n) { return strncmp(a, b, n); }
+
+#endif
@@ -0,0 +1,27 @@
+/*
+ * Minimal host test helpers for DC Motor Speed Control Project
+ */
+
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdio.h>
+
+static int testFailures = 0;
+
+// Record a failed expectation and keep going
+#define EXPECT(condition) \
+    do { \
+        if (!(condition)) { \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+            testFailures++; \
+        } \
+    } while (0)
+
+// Print the summary line and return the exit status
+static int testResult(const char* name) {
+    printf("%s: %s\n", name, testFailures ? "FAILED" : "ok");
+    return testFailures ? 1 : 0;
+}
+
+#endif
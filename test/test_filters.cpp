@@ -0,0 +1,125 @@
+/*
+ * Host tests of the measurement filters for DC Motor Speed Control Project
+ *
+ * Checks the IIR stages against the frequency response of their discrete
+ * transfer function, at two sample intervals to show that the time
+ * constant holds in ms, and the median and moving average stages on spikes
+ * and steps. The measured response is printed as CSV.
+ */
+
+#include <math.h>
+#include "test.h"
+#include "filters.h"
+
+const float PI_F = 3.14159265f;
+
+// Steady state amplitude of the filter output for a sine input
+static float measureGain(uint8_t chain, uint8_t shift, unsigned long dtMicros, float hz) {
+    FilterChannel filter;
+    initializeFilter(filter, chain);
+
+    const float amplitude = 400.0f;
+    const float dt = dtMicros * 1e-6f;
+    unsigned long settle = (unsigned long)(1.0f / dt);          // 1 s
+    unsigned long samples = settle + (unsigned long)(2.0f / (hz * dt)) + 1;  // Two periods after
+    float lowest = 1e9f, highest = -1e9f;
+
+    for (unsigned long n = 0; n < samples; n++) {
+        uint16_t sample = (uint16_t)lroundf(2048.0f + amplitude * sinf(2 * PI_F * hz * n * dt));
+        uint16_t output = applyFilter(filter, sample, shift, dtMicros);
+        if (n >= settle) {
+            lowest = fminf(lowest, output);
+            highest = fmaxf(highest, output);
+        }
+    }
+    return (highest - lowest) / (2 * amplitude);
+}
+
+// Gain of y += a (x - y) at hz, stages in cascade
+static float expectedGain(uint8_t stages, uint8_t shift, unsigned long dtMicros, float hz) {
+    float dt = dtMicros * 1e-6f;
+    float tau = (1000UL << shift) * 1e-6f;
+    float a = dt / (tau + dt);
+    float w = 2 * PI_F * hz * dt;
+    float re = 1 - (1 - a) * cosf(w);
+    float im = (1 - a) * sinf(w);
+    return powf(a / sqrtf(re * re + im * im), stages);
+}
+
+static void testFrequencyResponse() {
+    const uint8_t shift = 4;                     // tau = 16 ms
+    const float corner = 1.0f / (2 * PI_F * 0.016f);
+    const float frequencies[] = {1, 5, 10, corner, 20, 40, 80};
+    const unsigned long intervals[] = {1000, 3000};
+
+    printf("# chain,dt_us,hz,gain,expected\n");
+    for (unsigned long dt : intervals) {
+        for (float hz : frequencies) {
+            float gain1 = measureGain(0, shift, dt, hz);
+            float gain2 = measureGain(FILTER_IIR2, shift, dt, hz);
+            float expected1 = expectedGain(1, shift, dt, hz);
+            float expected2 = expectedGain(2, shift, dt, hz);
+            printf("iir1,%lu,%.2f,%.3f,%.3f\n", dt, hz, gain1, expected1);
+            printf("iir2,%lu,%.2f,%.3f,%.3f\n", dt, hz, gain2, expected2);
+            EXPECT(fabsf(gain1 - expected1) < 0.02f);
+            EXPECT(fabsf(gain2 - expected2) < 0.02f);
+        }
+    }
+
+    // The corner stays near -3 dB whether the loop runs at 1 or 3 ms
+    for (unsigned long dt : intervals) {
+        float gain = measureGain(0, shift, dt, corner);
+        EXPECT(gain > 0.64f && gain < 0.77f);
+    }
+}
+
+static void testBypass() {
+    FilterChannel filter;
+    initializeFilter(filter, 0);
+    EXPECT(applyFilter(filter, 100, 0, 1000) == 100);
+    EXPECT(applyFilter(filter, 900, 0, 1000) == 900);
+
+    // Enabling the IIR later starts from the last output, without a step
+    EXPECT(applyFilter(filter, 900, 3, 1000) == 900);
+}
+
+static void testMedianRejectsSpikes() {
+    FilterChannel filter;
+    initializeFilter(filter, FILTER_MEDIAN3);
+    for (int n = 0; n < 10; n++) {
+        uint16_t sample = (n == 5) ? 1023 : 300;
+        EXPECT(applyFilter(filter, sample, 0, 1000) == 300);
+    }
+}
+
+static void testAverageStep() {
+    FilterChannel filter;
+    initializeFilter(filter, FILTER_AVERAGE);
+    applyFilter(filter, 0, 0, 1000);
+
+    uint16_t output = 0;
+    for (uint8_t n = 0; n < FILTER_AVERAGE_LENGTH; n++) {
+        output = applyFilter(filter, 400, 0, 1000);
+        EXPECT(n == FILTER_AVERAGE_LENGTH - 1 || output < 400);
+    }
+    EXPECT(output == 400);
+}
+
+// A long pass (display transfer) counts as FILTER_DT_MAX, so the output
+// moves further but never overshoots
+static void testLongInterval() {
+    FilterChannel filter;
+    initializeFilter(filter, 0);
+    applyFilter(filter, 0, 6, 1000);
+    uint16_t output = applyFilter(filter, 1000, 6, 1000000);
+    EXPECT(output > 150 && output < 1000);
+}
+
+int main() {
+    testFrequencyResponse();
+    testBypass();
+    testMedianRejectsSpikes();
+    testAverageStep();
+    testLongInterval();
+    return testResult("test_filters");
+}
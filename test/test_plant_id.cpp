@@ -0,0 +1,65 @@
+/*
+ * Host test of the online plant identification for DC Motor Speed Control Project
+ *
+ * Runs the firmware against the motor model with a series of setpoint
+ * steps and checks the fitted gain and time constant against the model,
+ * then the drift flag after the load of the motor changes.
+ */
+
+#include <math.h>
+#include "test.h"
+#include "host_firmware.h"
+#include "plant_id.h"
+#include "pid.h"
+
+// Relative deviation of a fitted value
+static float deviation(float fitted, float actual) {
+    return fabsf(fitted - actual) / actual;
+}
+
+// Alternate the setpoint to keep the fit excited
+static void exciteMotor(MotorModel& motor, unsigned long ms) {
+    const uint16_t setpoints[] = {1500, 900, 2100, 1200};
+    for (unsigned long t = 0; t < ms; t += 1000) {
+        setSpeedSetpoint(activeAxis(), setpoints[(t / 1000) % 4]);
+        runFirmware(motor, 1000);
+    }
+}
+
+int main() {
+    MotorModel motor = defaultMotor();
+    motor.noiseRpm = 10;  // Without noise a fitted model sees no errors above the deadband
+    char output[2048];
+    PlantModel model;
+
+    setup();
+    systemParams.kp = 0.1;
+    systemParams.ki = 0.5;
+    updatePIDParameters();
+    takeOutput(output, sizeof(output));
+
+    startMotor(activeAxis());
+    exciteMotor(motor, 16000);
+
+    EXPECT(activeAxis().state == STATE_RUN);
+    EXPECT(getPlantModel(activeAxis(), model));
+    printf("# gain=%.2f/%.2f tau=%.3f/%.3f\n", model.gain, motorGain(motor), model.tau, motorTau(motor));
+    EXPECT(deviation(model.gain, motorGain(motor)) < 0.15);
+    EXPECT(deviation(model.tau, motorTau(motor)) < 0.15);
+
+    // The fit as the baseline, then a doubled inertia
+    EXPECT(savePlantBaseline(activeAxis()));
+    EXPECT(!isPlantDrifting(activeAxis()));
+    motor.rpmPerAmpSecond /= 2;
+    exciteMotor(motor, 20000);
+    EXPECT(getPlantModel(activeAxis(), model));
+    printf("# tau after=%.3f/%.3f\n", model.tau, motorTau(motor));
+    EXPECT(isPlantDrifting(activeAxis()));
+
+    sendCommand("IDENT");
+    runFirmware(motor, 100);
+    takeOutput(output, sizeof(output));
+    EXPECT(reportValue(output, "axis1_drift", -1) == 1);
+
+    return testResult("test_plant_id");
+}
@@ -0,0 +1,123 @@
+/*
+ * Host benchmark of the input scaling for DC Motor Speed Control Project
+ *
+ * Checks the integer conversions and raw count thresholds of scaling.h
+ * against the float mapf() path they replaced, over every ADC count and a
+ * range of full scales, then times both paths and the current readout
+ * formatting. Host times only compare the two paths; the counts on the
+ * target come from the BENCH serial command.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <chrono>
+#include "test.h"
+#include "host_firmware.h"
+#include "scaling.h"
+#include "utils.h"
+
+const uint32_t BENCH_PASSES = 2000;  // Passes over all ADC counts per timing
+
+// The float conversion used before scaling.h
+static float mapf(float x, float inMin, float inMax, float outMin, float outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+static void setFullScale(int speed, float current) {
+    systemParams.speedFullScale = speed;
+    systemParams.currentFullScale = current;
+    updateScaling();
+}
+
+static void testEquivalence() {
+    const int speeds[] = {500, 1000, 3000, 6000, 10000};
+    const float currents[] = {1.0f, 5.0f, 30.0f, 50.0f};
+
+    for (int speed : speeds) {
+        for (float current : currents) {
+            setFullScale(speed, current);
+            for (uint16_t raw = 0; raw < ADC_RESOLUTION; raw++) {
+                float rpm = mapf(raw, 0, ADC_RESOLUTION - 1, 0, speed);
+                float amps = mapf(raw, 0, ADC_RESOLUTION - 1, 0, current);
+
+                // Rounded, where the float path was truncated
+                EXPECT(fabsf(scaleSpeed(raw) - rpm) < 1);
+                EXPECT(fabsf(scaleCurrent(raw) - amps * 1000) < 1);
+                EXPECT((raw >= inputScaling.overcurrentRaw) ==
+                       (amps >= current * OVERCURRENT_THRESHOLD));
+                EXPECT((raw >= inputScaling.softStartLimitRaw) ==
+                       (amps >= current * SOFT_START_CURRENT_LIMIT));
+            }
+        }
+    }
+}
+
+// Print that only counts, so the timing is of the formatting
+class NullPrint : public Print {
+public:
+    size_t write(uint8_t c) { count++; return 1; }
+    using Print::write;
+    uint32_t count = 0;
+};
+
+static double nanosPerCall(std::chrono::steady_clock::time_point start, uint32_t calls) {
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / calls;
+}
+
+static void benchmark() {
+    const uint32_t calls = BENCH_PASSES * ADC_RESOLUTION;
+    volatile uint32_t sink = 0;
+    char text[24];
+    NullPrint out;
+
+    setFullScale(DEFAULT_SPEED_FULL_SCALE, DEFAULT_CURRENT_FULL_SCALE);
+
+    // Speed, current and overcurrent test of one readInputs() pass
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++) {
+        for (volatile uint16_t raw = 0; raw < ADC_RESOLUTION; raw++) {
+            float rpm = mapf(raw, 0, ADC_RESOLUTION - 1, 0, systemParams.speedFullScale);
+            float amps = mapf(raw, 0, ADC_RESOLUTION - 1, 0, systemParams.currentFullScale);
+            sink += (uint16_t)rpm + (amps >= systemParams.currentFullScale * OVERCURRENT_THRESHOLD);
+        }
+    }
+    printf("inputs_float_ns=%.2f\n", nanosPerCall(start, calls));
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++) {
+        for (volatile uint16_t raw = 0; raw < ADC_RESOLUTION; raw++) {
+            uint16_t milliAmps = scaleCurrent(raw);
+            sink += scaleSpeed(raw) + (raw >= inputScaling.overcurrentRaw) + (milliAmps & 1);
+        }
+    }
+    printf("inputs_integer_ns=%.2f\n", nanosPerCall(start, calls));
+
+    // Current readout with one decimal
+    start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++) {
+        for (volatile uint16_t raw = 0; raw < ADC_RESOLUTION; raw++) {
+            float amps = mapf(raw, 0, ADC_RESOLUTION - 1, 0, systemParams.currentFullScale);
+            int intPart = (int)amps;
+            int decimalPart = (int)((amps - intPart) * 10);
+            snprintf(text, sizeof(text), "%d.%d", intPart, decimalPart);
+            out.print(text);
+        }
+    }
+    printf("readout_float_ns=%.2f\n", nanosPerCall(start, calls));
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t pass = 0; pass < BENCH_PASSES; pass++) {
+        for (volatile uint16_t raw = 0; raw < ADC_RESOLUTION; raw++) {
+            printFixed(out, (scaleCurrent(raw) + 50) / 100, 1);
+        }
+    }
+    printf("readout_integer_ns=%.2f\n", nanosPerCall(start, calls));
+    EXPECT(sink != 0 && out.count > 0);
+}
+
+int main() {
+    testEquivalence();
+    benchmark();
+    return testResult("test_scaling");
+}
@@ -0,0 +1,316 @@
+/*
+ * Control performance scenarios for DC Motor Speed Control Project
+ *
+ * Runs the firmware against the motor model through a library of
+ * scenarios: setpoint steps, load steps, a ramp, sensor noise, a soft start
+ * held at the current limit, a stalled start and an overcurrent trip. For each it prints a
+ * CSV row of IAE and ISE of the true motor speed against the reference,
+ * overshoot, settling time and time in alarm, plus the host time per
+ * readInputs() and processPID() call.
+ *
+ * The metrics are compared with scenarios.csv next to the test binary, or
+ * the file given on the command line; a metric that rises above its
+ * baseline by more than the tolerance of that metric fails the test, so a
+ * change to the control core cannot make the response worse unnoticed.
+ * After an intended change, rewrite the baseline with
+ * ./test_scenarios --update [baseline.csv].
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include "test.h"
+#include "host_firmware.h"
+#include "pid.h"
+#include "scaling.h"
+
+const char SCENARIO_BASELINE[] = "scenarios.csv";
+const uint32_t TIMING_CALLS = 20000;      // Calls per timing
+
+// Regression allowed for a metric: a fraction of the baseline plus a slack
+// in the units of the metric
+struct Tolerance {
+    float relative;
+    float slack;
+};
+
+const Tolerance IAE_TOLERANCE = {0.05f, 1};        // RPM*s
+const Tolerance ISE_TOLERANCE = {0.10f, 100};      // RPM^2*s, moves about twice as much as IAE
+const Tolerance OVERSHOOT_TOLERANCE = {0.05f, 2};  // RPM
+const Tolerance SETTLING_TOLERANCE = {0.05f, 10};  // ms
+const Tolerance ALARM_TOLERANCE = {0, 5};          // ms, set by the alarm delays, not by the tuning
+
+// Response over one scenario window
+struct Metrics {
+    float iae;                 // RPM*s
+    float ise;                 // RPM^2*s
+    float overshoot;           // RPM past the reference in the direction of the step
+    float settlingMs;          // Last time the error left the band
+    float alarmMs;             // Time in alarm
+};
+
+struct Window {
+    float from, to;            // Reference before and after the step
+    unsigned long ms;
+    Metrics metrics;
+};
+
+static MotorModel motor;
+
+static void openWindow(Window& window, float from, float to) {
+    memset(&window, 0, sizeof(window));
+    window.from = from;
+    window.to = to;
+}
+
+// Run the firmware for ms against a reference, sampling every ms
+static void runWindow(Window& window, float reference, unsigned long ms) {
+    Metrics& m = window.metrics;
+    float band = fmaxf(fabsf(window.to - window.from) * 0.02f, 10);
+
+    for (unsigned long t = 0; t < ms; t++) {
+        runFirmware(motor, 1);
+        window.ms++;
+
+        if (activeAxis().state == STATE_ALARM) {
+            m.alarmMs++;
+        }
+        float error = reference - motor.rpm;
+        m.iae += fabsf(error) * 1e-3f;
+        m.ise += error * error * 1e-3f;
+        float excursion = window.to >= window.from ? -error : error;
+        m.overshoot = fmaxf(m.overshoot, excursion);
+        if (fabsf(error) > band) {
+            m.settlingMs = window.ms;
+        }
+    }
+}
+
+// Bring the motor to a speed from rest or from the present setpoint
+static void runAt(uint16_t rpm, unsigned long ms) {
+    setSpeedSetpoint(activeAxis(), rpm);
+    if (activeAxis().state == STATE_IDLE) {
+        startMotor(activeAxis());
+    }
+    runFirmware(motor, ms);
+}
+
+// Stop, wait for IDLE and start the next scenario from a fresh motor
+static void rest() {
+    stopMotor(activeAxis());
+    for (int t = 0; t < 10000 && (activeAxis().state != STATE_IDLE || motor.rpm > 0); t += 100) {
+        runFirmware(motor, 100);
+    }
+    motor = defaultMotor();
+    runFirmware(motor, 100);
+}
+
+static void stepUp(Window& window) {
+    runAt(1000, 3000);
+    openWindow(window, 1000, 2000);
+    setSpeedSetpoint(activeAxis(), 2000);
+    runWindow(window, 2000, 2000);
+}
+
+static void stepDown(Window& window) {
+    runAt(2000, 3000);
+    openWindow(window, 2000, 1000);
+    setSpeedSetpoint(activeAxis(), 1000);
+    runWindow(window, 1000, 2000);
+}
+
+static void loadStep(Window& window) {
+    runAt(1500, 3000);
+    openWindow(window, 1500, 1500);
+    motor.loadAmps = 8;
+    runWindow(window, 1500, 1500);
+    motor.loadAmps = 0;
+    runWindow(window, 1500, 1500);
+}
+
+// 500 to 2500 RPM at 1000 RPM/s
+static void ramp(Window& window) {
+    runAt(500, 3000);
+    openWindow(window, 500, 2500);
+    for (uint16_t setpoint = 510; setpoint <= 2500; setpoint += 10) {
+        setSpeedSetpoint(activeAxis(), setpoint);
+        runWindow(window, setpoint, 10);
+    }
+    runWindow(window, 2500, 1000);
+}
+
+static void noisyStep(Window& window) {
+    motor.noiseRpm = 30;
+    runAt(1000, 3000);
+    openWindow(window, 1000, 2000);
+    setSpeedSetpoint(activeAxis(), 2000);
+    runWindow(window, 2000, 2000);
+}
+
+// A loaded start: the soft start ramp holds at the current limit
+static void currentLimit(Window& window) {
+    motor.loadAmps = 10;
+    openWindow(window, 0, 2000);
+    setSpeedSetpoint(activeAxis(), 2000);
+    startMotor(activeAxis());
+    runWindow(window, 2000, 4000);
+}
+
+// A load above the soft start current limit: the start times out
+static void stalledStart(Window& window) {
+    motor.loadAmps = 25;
+    openWindow(window, 0, 2000);
+    setSpeedSetpoint(activeAxis(), 2000);
+    startMotor(activeAxis());
+    runWindow(window, 2000, SOFT_START_TIMEOUT + 1000);
+    EXPECT(activeAxis().state == STATE_ALARM);
+    EXPECT(activeAxis().alarm == ALARM_START_TIMEOUT);
+    motor.loadAmps = 0;
+}
+
+// A jammed load trips the overcurrent alarm; once it clears the motor is
+// started again
+static void overcurrent(Window& window) {
+    runAt(1500, 3000);
+    openWindow(window, 1500, 1500);
+    motor.loadAmps = 40;
+    runWindow(window, 1500, 500);
+    motor.loadAmps = 0;
+    runWindow(window, 1500, 5500);
+    runAt(1500, 0);
+    runWindow(window, 1500, 3000);
+}
+
+struct Scenario {
+    const char* name;
+    void (*run)(Window& window);
+};
+
+const Scenario SCENARIOS[] = {
+    {"step_up", stepUp},
+    {"step_down", stepDown},
+    {"load_step", loadStep},
+    {"ramp", ramp},
+    {"noisy_step", noisyStep},
+    {"current_limit", currentLimit},
+    {"stalled_start", stalledStart},
+    {"overcurrent", overcurrent},
+};
+const uint8_t SCENARIO_COUNT = sizeof(SCENARIOS) / sizeof(SCENARIOS[0]);
+
+// Host time of the two control core calls, motor running
+static void timeControlCore(double& readInputsNs, double& processPidNs) {
+    std::chrono::duration<double, std::nano> readTime(0), pidTime(0);
+    MotorAxis& axis = activeAxis();
+
+    for (uint32_t i = 0; i < TIMING_CALLS; i++) {
+        hostAdvance(PID_COMPUTE_INTERVAL * 1000);   // Every call computes
+        auto start = std::chrono::steady_clock::now();
+        readInputs(axis);
+        auto middle = std::chrono::steady_clock::now();
+        processPID(axis);
+        auto end = std::chrono::steady_clock::now();
+        readTime += middle - start;
+        pidTime += end - middle;
+    }
+    readInputsNs = readTime.count() / TIMING_CALLS;
+    processPidNs = pidTime.count() / TIMING_CALLS;
+}
+
+// Compare a metric with its baseline
+static void checkMetric(const char* scenario, const char* name, float value, float baseline,
+                        const Tolerance& tolerance) {
+    if (value > baseline * (1 + tolerance.relative) + tolerance.slack) {
+        printf("FAIL %s %s=%.1f baseline=%.1f\n", scenario, name, value, baseline);
+        testFailures++;
+    }
+}
+
+static bool findBaseline(FILE* file, const char* scenario, Metrics& baseline) {
+    char line[160], name[32];
+
+    rewind(file);
+    while (fgets(line, sizeof(line), file)) {
+        if (sscanf(line, "%31[^,],%f,%f,%f,%f,%f", name, &baseline.iae, &baseline.ise,
+                   &baseline.overshoot, &baseline.settlingMs, &baseline.alarmMs) == 6 &&
+            strcmp(name, scenario) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Baseline in the directory of the test binary, so the result does not
+// depend on where the test is run from
+static void defaultBaselinePath(char* path, size_t size, const char* program) {
+    const char* slash = strrchr(program, '/');
+    int directoryLength = slash ? slash - program + 1 : 0;
+    snprintf(path, size, "%.*s%s", directoryLength, program, SCENARIO_BASELINE);
+}
+
+int main(int argc, char** argv) {
+    bool update = false;
+    char baselinePath[256];
+    const char header[] = "scenario,iae_rpm_s,ise_rpm2_s,overshoot_rpm,settling_ms,alarm_ms";
+    char output[1024];
+    Window windows[SCENARIO_COUNT];
+
+    defaultBaselinePath(baselinePath, sizeof(baselinePath), argv[0]);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            snprintf(baselinePath, sizeof(baselinePath), "%s", argv[i]);
+        }
+    }
+    FILE* baselineFile = fopen(baselinePath, update ? "w" : "r");
+    if (!baselineFile) {
+        printf("cannot open %s\n", baselinePath);
+        return 1;
+    }
+
+    motor = defaultMotor();
+    setup();
+    systemParams.kp = 0.1;
+    systemParams.ki = 0.8;
+    updatePIDParameters();
+
+    for (uint8_t i = 0; i < SCENARIO_COUNT; i++) {
+        SCENARIOS[i].run(windows[i]);
+        rest();
+        takeOutput(output, sizeof(output));
+    }
+
+    double readInputsNs, processPidNs;
+    runAt(1500, 3000);
+    timeControlCore(readInputsNs, processPidNs);
+
+    printf("%s,read_inputs_ns,process_pid_ns\n", header);
+    if (update) {
+        fprintf(baselineFile, "%s\n", header);
+    }
+    for (uint8_t i = 0; i < SCENARIO_COUNT; i++) {
+        const char* name = SCENARIOS[i].name;
+        const Metrics& m = windows[i].metrics;
+        Metrics baseline;
+
+        printf("%s,%.1f,%.0f,%.1f,%.0f,%.0f,%.1f,%.1f\n", name, m.iae, m.ise, m.overshoot,
+               m.settlingMs, m.alarmMs, readInputsNs, processPidNs);
+        if (update) {
+            fprintf(baselineFile, "%s,%.1f,%.0f,%.1f,%.0f,%.0f\n", name, m.iae, m.ise,
+                    m.overshoot, m.settlingMs, m.alarmMs);
+        } else if (!findBaseline(baselineFile, name, baseline)) {
+            printf("FAIL %s has no baseline\n", name);
+            testFailures++;
+        } else {
+            checkMetric(name, "iae", m.iae, baseline.iae, IAE_TOLERANCE);
+            checkMetric(name, "ise", m.ise, baseline.ise, ISE_TOLERANCE);
+            checkMetric(name, "overshoot", m.overshoot, baseline.overshoot, OVERSHOOT_TOLERANCE);
+            checkMetric(name, "settling", m.settlingMs, baseline.settlingMs, SETTLING_TOLERANCE);
+            checkMetric(name, "alarm", m.alarmMs, baseline.alarmMs, ALARM_TOLERANCE);
+        }
+    }
+    fclose(baselineFile);
+    return testResult("test_scenarios");
+}
@@ -0,0 +1,184 @@
+/*
+ * Host simulator of master/follower speed sync for DC Motor Speed Control Project
+ *
+ * A master and two follower drives run in this process, each a separate
+ * copy of the firmware (drive_instance.cpp loaded with dlmopen()), with
+ * the master's sync link output forwarded to the followers every ms.
+ * Checks the follower setpoints at steady speed and during a ramp, frame
+ * loss counting, the slope of a speed jump steeper than a frame can carry,
+ * and ALARM_REFERENCE_LOSS when the link is cut.
+ */
+
+#include <dlfcn.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "test.h"
+#include "config.h"      // For SyncMode
+#include "alarms.h"      // For AlarmType
+#include "states.h"      // For SystemState
+#include "speed_sync.h"  // For SYNC_TIMEOUT
+
+const char DRIVE_LIBRARY[] = "build/libdrive.so";
+const uint8_t FOLLOWER_COUNT = 2;
+
+// Entry points of one loaded drive
+struct Drive {
+    void (*setup)(uint8_t syncMode, float ratio, int trim);
+    void (*run)(unsigned long ms);
+    void (*start)(uint16_t setpoint);
+    void (*setSetpoint)(uint16_t setpoint);
+    void (*setMotorSpeed)(float rpm);
+    int (*linkTake)();
+    void (*linkReceive)(uint8_t c);
+    uint16_t (*speed)();
+    float (*setpoint)();
+    uint8_t (*state)();
+    uint8_t (*alarm)();
+    uint16_t (*lostFrames)();
+    float ratio;
+    int trim;
+};
+
+static Drive master;
+static Drive followers[FOLLOWER_COUNT];
+
+template <class T> static void bind(void* library, T& function, const char* name) {
+    function = (T)dlsym(library, name);
+    if (!function) {
+        printf("missing %s\n", name);
+        exit(1);
+    }
+}
+
+// Load a fresh copy of the firmware and start it in the given sync role
+static void loadDrive(Drive& drive, uint8_t syncMode, float ratio, int trim) {
+    void* library = dlmopen(LM_ID_NEWLM, DRIVE_LIBRARY, RTLD_NOW | RTLD_LOCAL);
+    if (!library) {
+        printf("%s\n", dlerror());
+        exit(1);
+    }
+    bind(library, drive.setup, "driveSetup");
+    bind(library, drive.run, "driveRun");
+    bind(library, drive.start, "driveStart");
+    bind(library, drive.setSetpoint, "driveSetSetpoint");
+    bind(library, drive.setMotorSpeed, "driveSetMotorSpeed");
+    bind(library, drive.linkTake, "driveLinkTake");
+    bind(library, drive.linkReceive, "driveLinkReceive");
+    bind(library, drive.speed, "driveSpeed");
+    bind(library, drive.setpoint, "driveSetpoint");
+    bind(library, drive.state, "driveState");
+    bind(library, drive.alarm, "driveAlarm");
+    bind(library, drive.lostFrames, "driveLostFrames");
+    drive.ratio = ratio;
+    drive.trim = trim;
+    drive.setup(syncMode, ratio, trim);
+}
+
+// Run all drives in 1 ms steps; the master frames reach the followers
+// unless the link is cut, and the frame number 'drop' is lost
+static void runDrives(unsigned long ms, bool linked = true, int drop = -1) {
+    int frameByte = 0;  // Frames are written whole, so this stays aligned
+
+    for (unsigned long t = 0; t < ms; t++) {
+        master.run(1);
+        int c;
+        while ((c = master.linkTake()) >= 0) {
+            bool dropped = frameByte / (int)sizeof(SyncFrame) == drop;
+            frameByte++;
+            for (Drive& follower : followers) {
+                if (linked && !dropped) {
+                    follower.linkReceive(c);
+                }
+            }
+        }
+        for (Drive& follower : followers) {
+            follower.run(1);
+        }
+    }
+}
+
+// Follower setpoint error against the master speed in RPM
+static float followerError(const Drive& follower) {
+    return follower.setpoint() - (master.speed() * follower.ratio + follower.trim);
+}
+
+static void testTracking() {
+    master.start(1500);
+    runDrives(1000);
+    for (Drive& follower : followers) {
+        follower.start(0);
+    }
+    runDrives(4000);
+
+    EXPECT(master.state() == STATE_RUN);
+    for (Drive& follower : followers) {
+        printf("# steady: master=%u follower=%u setpoint=%.0f\n",
+               master.speed(), follower.speed(), follower.setpoint());
+        EXPECT(follower.state() == STATE_RUN);
+        EXPECT(fabsf(followerError(follower)) < 10);
+        EXPECT(fabsf(follower.speed() - follower.setpoint()) < 15);
+    }
+
+    // Ramp the master; the slope in the frames keeps the lag small
+    float worst = 0;
+    for (uint16_t setpoint = 1500; setpoint <= 2400; setpoint += 5) {
+        master.setSetpoint(setpoint);
+        runDrives(10);
+        worst = fmaxf(worst, fabsf(followerError(followers[0])));
+    }
+    runDrives(2000);
+    printf("# ramp: worst setpoint error=%.1f RPM\n", worst);
+    EXPECT(worst < 30);
+    EXPECT(fabsf(followerError(followers[1])) < 10);
+}
+
+static void testLostFrame() {
+    uint16_t before = followers[0].lostFrames();
+    runDrives(100, true, 2);
+    EXPECT(followers[0].lostFrames() == before + 1);
+    EXPECT(followers[0].state() == STATE_RUN);
+}
+
+// A drop of 1200 RPM within one broadcast period is beyond the int16 slope
+// of a frame; the followers must still extrapolate downwards
+static void testSpeedJump() {
+    master.setMotorSpeed(1200);
+    for (int t = 0; t < 100 && followers[0].setpoint() > 2000; t++) {
+        runDrives(1);
+    }
+    float arrived = followers[0].setpoint();
+    runDrives(10);
+    printf("# jump: follower setpoint %.0f then %.0f\n", arrived, followers[0].setpoint());
+    EXPECT(arrived <= 2000);
+    EXPECT(followers[0].setpoint() < arrived);
+
+    // Settle back on the master before the link is cut
+    runDrives(3000);
+    EXPECT(fabsf(followerError(followers[0])) < 10);
+}
+
+static void testReferenceLoss() {
+    runDrives(SYNC_TIMEOUT - 50, false);
+    for (Drive& follower : followers) {
+        EXPECT(follower.state() == STATE_RUN);
+    }
+    runDrives(100, false);
+    for (Drive& follower : followers) {
+        EXPECT(follower.state() == STATE_ALARM);
+        EXPECT(follower.alarm() == ALARM_REFERENCE_LOSS);
+    }
+    EXPECT(master.state() == STATE_RUN);
+}
+
+int main() {
+    loadDrive(master, SYNC_MASTER, 1, 0);
+    loadDrive(followers[0], SYNC_FOLLOWER, 1.0, 0);
+    loadDrive(followers[1], SYNC_FOLLOWER, 0.5, 100);
+
+    testTracking();
+    testLostFrame();
+    testSpeedJump();
+    testReferenceLoss();
+    return testResult("test_sync");
+}
@@ -0,0 +1,25 @@
+#!/bin/sh
+# Static RAM per module for the DC Motor Speed Control Project
+#
+# Usage: tools/ram_report.sh <build dir>
+#
+# Build first with e.g.
+#   arduino-cli compile -b arduino:megaavr:nona4809 --build-path build MotorSpeedControlProject
+# then pass the build path. Every object file of the sketch is listed with
+# its .data + .bss size (bytes of SRAM used before the stack), largest first,
+# followed by the totals of the linked program.
+
+BUILD_DIR=${1:?usage: $0 <build dir>}
+SIZE=${AVR_SIZE:-avr-size}
+RAM_TOTAL=6144   # ATmega4809 SRAM
+
+echo "module                          data   bss   ram"
+for obj in "$BUILD_DIR"/sketch/*.o; do
+    "$SIZE" "$obj" | awk -v name="$(basename "$obj" .o)" \
+        'NR == 2 { printf "%-30s %5d %5d %5d\n", name, $2, $3, $2 + $3 }'
+done | sort -k4 -n -r
+
+for elf in "$BUILD_DIR"/*.elf; do
+    "$SIZE" "$elf" | awk -v total=$RAM_TOTAL \
+        'NR == 2 { ram = $2 + $3; printf "\nprogram: %d bytes static RAM, %d left for stack (%d%% used)\n", ram, total - ram, ram * 100 / total }'
+done